@@ -32,9 +32,11 @@ git clone https://github.com/rdkcentral/rdk-halif-device_settings.git
 echo "Building IARMBus stubs"
 cd $WORKDIR
 cd ./stubs
-g++ -fPIC -shared -o libIARMBus.so iarm_stubs.cpp -I$WORKDIR/stubs -I/usr/include/glib-2.0 -I/usr/lib/x86_64-linux-gnu/glib-2.0/include -I$IARMBUS_PATH/core -I$IARMBUS_PATH/core/include -I$ROOT/devicesettings/rpc/include -I$ROOT/rdk-halif-device_settings/include/ -fpermissive
-g++ -fPIC -shared -o libWPEFrameworkPowerController.so powerctrl_stubs.cpp  -I$WORKDIR/stubs -fpermissive
+g++ -fPIC -shared -o libIARMBus.so iarm_stubs.cpp -I$WORKDIR/stubs -I/usr/include/glib-2.0 -I/usr/lib/x86_64-linux-gnu/glib-2.0/include -I$IARMBUS_PATH/core -I$IARMBUS_PATH/core/include -I$ROOT/devicesettings/rpc/include -I$ROOT/rdk-halif-device_settings/include/ -fpermissive -lpthread
+g++ -o iarm-broker iarm_broker.cpp -I$WORKDIR/stubs
+g++ -fPIC -shared -o libWPEFrameworkPowerController.so powerctrl_stubs.cpp  -I$WORKDIR/stubs -fpermissive -lpthread
 
 
 cp libIARMBus.so /usr/local/lib
+cp iarm-broker /usr/local/bin
 cp libWPEFrameworkPowerController.so /usr/local/lib/libWPEFrameworkPowerController.so
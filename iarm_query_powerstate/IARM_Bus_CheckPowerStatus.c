@@ -17,44 +17,20 @@
  * limitations under the License.
  */
 #include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "power_controller.h"
-
-#define PADDING_SIZE 32
-
-/**
- * @brief All possible power states
-*/
-typedef enum _Daemon_PowerState_t
-{
-    PWRMGR_POWERSTATE_OFF,                  /*!< Power state OFF */
-    PWRMGR_POWERSTATE_STANDBY,              /*!< Power state STANDBY */
-    PWRMGR_POWERSTATE_ON,                   /*!< Power state ON */
-    PWRMGR_POWERSTATE_STANDBY_LIGHT_SLEEP,  /*!< Power state Standby Light Sleep */
-    PWRMGR_POWERSTATE_STANDBY_DEEP_SLEEP,   /*!< Power state DeepSleep power saving mode */
-    PWRMGR_POWERSTATE_MAX                   /*!< Out of range - required to be the last item of the enum */
-} PWRMgr_PowerState_t;
-
-/*LED settings*/
-typedef struct _PWRMgr_LED_Settings_t {
-    unsigned int brightness;
-    unsigned int color;
-} PWRMgr_LED_Settings_t;
-
-typedef struct _PWRMgr_Settings_t {
-    uint32_t magic;
-    uint32_t version;
-    uint32_t length;
-    PWRMgr_PowerState_t powerState;
-    PWRMgr_LED_Settings_t ledSettings;
-    uint32_t deep_sleep_timeout;
-    char padding[PADDING_SIZE];
-} PWRMgr_Settings_t;
+#include "powerConnect.h"
+#include "powerStateShm.h"
+#include "uimgrSettings.h"
 
 void usage()
 {
@@ -62,6 +38,11 @@ void usage()
     printf("\tCMDs are,\n");
     printf("\t\t -h       -> Help\n");
     printf("\t\t -c       -> Box state from PowerManager plugin\n");
+    printf("\t\t -s       -> Box state published by pwr-state-monitor in shared memory,\n");
+    printf("\t\t             as -c when the monitor is not running\n");
+    printf("\t\t -w [-j]  -> Print the box state, then one line per change until interrupted\n");
+    printf("\t\t             (--watch [--json]), -j prints JSON lines\n");
+    printf("\t\t -b       -> All settings from '/opt' at once as key=value lines (--bulk)\n");
     printf("\t\t No CMD will read the iARM state from '/opt'\n");
 
     printf("\n\tOutput will be,\n");
@@ -72,87 +53,225 @@ void usage()
     printf("\t\t\t OFF        -> Box id OFF\n");
 }
 
+static const char* stateName(PowerController_PowerState_t state)
+{
+    switch (state) {
+    case POWER_STATE_OFF: return "OFF";
+    case POWER_STATE_STANDBY: return "STANDBY";
+    case POWER_STATE_ON: return "ON";
+    case POWER_STATE_STANDBY_LIGHT_SLEEP: return "LIGHTSLEEP";
+    case POWER_STATE_STANDBY_DEEP_SLEEP: return "DEEPSLEEP";
+    default: return "Unknown";
+    }
+}
+
+static const char* settingsStateName(PWRMgr_PowerState_t state)
+{
+    switch (state) {
+    case PWRMGR_POWERSTATE_OFF: return "OFF";
+    case PWRMGR_POWERSTATE_STANDBY: return "STANDBY";
+    case PWRMGR_POWERSTATE_ON: return "ON";
+    case PWRMGR_POWERSTATE_STANDBY_LIGHT_SLEEP: return "LIGHTSLEEP";
+    case PWRMGR_POWERSTATE_STANDBY_DEEP_SLEEP: return "DEEPSLEEP";
+    default: return "Unknown Power state";
+    }
+}
+
+/* One query of the PowerManager plugin, -c */
+static void queryPowerController(void)
+{
+    uint32_t res = 0;
+    PowerController_PowerState_t curState = POWER_STATE_UNKNOWN, previousState = POWER_STATE_UNKNOWN;
+
+    PowerController_Init();
+
+    /** Query current Power state  */
+    res = PowerController_GetPowerState(&curState, &previousState);
+
+    if (POWER_CONTROLLER_ERROR_NONE == res) {
+        printf("%s\n", stateName(curState));
+    } else if (POWER_CONTROLLER_ERROR_UNAVAILABLE == res) {
+        printf("Error :: PowerManager plugin unavailable\n");
+    } else {
+        printf("Error :: Unknown\n");
+    }
+
+    /* Dispose closes RPC conn, do not make any power manager calls after this */
+    PowerController_Term();
+}
+
+/* Everything the settings file holds in one go, fields the file predates are left out */
+static int printSettings(void)
+{
+    UimgrSettings_t settings;
+    UimgrSettings_Status_t status = UimgrSettings_Read(UIMGR_SETTINGS_FILE, UIMGR_SETTINGS_CACHE, &settings);
+
+    if (status != UIMGR_SETTINGS_OK) {
+        printf("Error in reading PWRMgr settings File (%s)\n", UimgrSettings_StatusText(status));
+        return 1;
+    }
+    printf("version=%u\n", settings.version);
+    printf("powerState=%s\n", settingsStateName(settings.powerState));
+    if (settings.fields & UIMGR_SETTINGS_HAS_LED) {
+        printf("ledBrightness=%u\n", settings.ledBrightness);
+        printf("ledColor=%u\n", settings.ledColor);
+    }
+    if (settings.fields & UIMGR_SETTINGS_HAS_DEEP_SLEEP_TIMEOUT) {
+        printf("deepSleepTimeout=%u\n", settings.deepSleepTimeout);
+    }
+    return 0;
+}
+
+/* Watch mode, the PowerController callbacks print under watchLock */
+static pthread_mutex_t watchLock = PTHREAD_MUTEX_INITIALIZER;
+static bool watchJson = false;
+static PowerController_PowerState_t watchState = POWER_STATE_UNKNOWN;
+
+static void printWatchEvent(const char* event, PowerController_PowerState_t state, PowerController_PowerState_t previous)
+{
+    struct timespec realtime, monotonic;
+    struct tm tm_info;
+    char ts[32] = "";
+
+    clock_gettime(CLOCK_REALTIME, &realtime);
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    if (gmtime_r(&realtime.tv_sec, &tm_info) != NULL) {
+        strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm_info);
+    }
+
+    if (watchJson) {
+        printf("{\"time\":\"%s.%03ldZ\",\"monotonic_ms\":%llu,\"event\":\"%s\",\"state\":\"%s\",\"previous\":\"%s\"}\n",
+               ts, realtime.tv_nsec / 1000000L,
+               ((unsigned long long)monotonic.tv_sec * 1000ULL) + ((unsigned long long)monotonic.tv_nsec / 1000000ULL),
+               event, stateName(state), stateName(previous));
+    } else {
+        printf("%s.%03ldZ %s %s previous=%s\n", ts, realtime.tv_nsec / 1000000L, event, stateName(state), stateName(previous));
+    }
+    /* Scripts read this through a pipe */
+    fflush(stdout);
+}
+
+static void _powerModeChangedHandler(const PowerController_PowerState_t currentState,
+                                     const PowerController_PowerState_t newState, void* userdata)
+{
+    pthread_mutex_lock(&watchLock);
+    /* A change from before the initial query is already part of it */
+    if (newState != watchState) {
+        printWatchEvent("changed", newState, currentState);
+        watchState = newState;
+    }
+    pthread_mutex_unlock(&watchLock);
+}
+
+/* Changes are not replayed after the plugin restarts, query the state again */
+static void _operationalStateChangeHandler(bool isOperational, void* userdata)
+{
+    PowerController_PowerState_t curState = POWER_STATE_UNKNOWN, previousState = POWER_STATE_UNKNOWN;
+
+    pthread_mutex_lock(&watchLock);
+    if (!isOperational) {
+        printWatchEvent("unavailable", watchState, watchState);
+    } else if ((PowerController_GetPowerState(&curState, &previousState) == POWER_CONTROLLER_ERROR_NONE) &&
+               (curState != watchState)) {
+        printWatchEvent("resync", curState, watchState);
+        watchState = curState;
+    }
+    pthread_mutex_unlock(&watchLock);
+}
+
+/* Connect once and stream the state changes until SIGINT or SIGTERM */
+static int watchPowerState(bool json)
+{
+    PowerController_PowerState_t curState = POWER_STATE_UNKNOWN, previousState = POWER_STATE_UNKNOWN;
+    sigset_t signals;
+    uint32_t res;
+    int sig = 0;
+
+    /* Block before the PowerController threads start so only sigwait sees them */
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    watchJson = json;
+    PowerController_Init();
+    /* The signals are blocked, so the wait has to look for them itself */
+    if (PowerConnect_WaitCancellable(0, NULL, PowerConnect_SignalPending, &signals) == POWER_CONNECT_CANCELLED) {
+        PowerController_Term();
+        return 0;
+    }
+
+    /* Subscribe first so no change falls between the query and the callback */
+    pthread_mutex_lock(&watchLock);
+    PowerController_RegisterPowerModeChangedCallback(_powerModeChangedHandler, NULL);
+    res = PowerController_GetPowerState(&curState, &previousState);
+    if (POWER_CONTROLLER_ERROR_NONE != res) {
+        pthread_mutex_unlock(&watchLock);
+        printf("Error :: %s\n", (POWER_CONTROLLER_ERROR_UNAVAILABLE == res) ? "PowerManager plugin unavailable" : "Unknown");
+        PowerController_UnRegisterPowerModeChangedCallback(_powerModeChangedHandler);
+        PowerController_Term();
+        return 1;
+    }
+    printWatchEvent("current", curState, previousState);
+    watchState = curState;
+    PowerController_RegisterOperationalStateChangeCallback(_operationalStateChangeHandler, NULL);
+    pthread_mutex_unlock(&watchLock);
+
+    sigwait(&signals, &sig);
+
+    PowerController_UnRegisterOperationalStateChangeCallback(_operationalStateChangeHandler);
+    PowerController_UnRegisterPowerModeChangedCallback(_powerModeChangedHandler);
+    PowerController_Term();
+    return 0;
+}
+
 /**
  * Test application to check whether the box is in standby or not.
  * This has been developed to resolve, XONE-4598
  */
 int main(int argc, char* argv[])
 {
-    int ret = 0;
-
     if (argc > 1) {
+        if ((strcmp(argv[1], "-w") == 0) || (strcmp(argv[1], "--watch") == 0)) {
+            bool json = (argc > 2) && ((strcmp(argv[2], "-j") == 0) || (strcmp(argv[2], "--json") == 0));
+            return watchPowerState(json);
+        }
+        if ((strcmp(argv[1], "-b") == 0) || (strcmp(argv[1], "--bulk") == 0)) {
+            return printSettings();
+        }
         // Copilot fix: Added bounds check to prevent array out-of-bounds access
         if (argv[1] && strlen(argv[1]) > 1 && argv[1][1] == 'c') {
-            uint32_t res = 0;
-            PowerController_PowerState_t curState = POWER_STATE_UNKNOWN, previousState = POWER_STATE_UNKNOWN;
-
-            PowerController_Init();
-
-            /** Query current Power state  */
-            res = PowerController_GetPowerState(&curState, &previousState);
-
-            if (POWER_CONTROLLER_ERROR_NONE == res) {
-
-                if (POWER_STATE_OFF == curState) {
-                    printf("OFF\n");
-                } else if (POWER_STATE_STANDBY == curState) {
-                    printf("STANDBY\n");
-                } else if (POWER_STATE_ON == curState) {
-                    printf("ON\n");
-                } else if (POWER_STATE_STANDBY_LIGHT_SLEEP == curState) {
-                    printf("LIGHTSLEEP\n");
-                } else if (POWER_STATE_STANDBY_DEEP_SLEEP == curState) {
-                    printf("DEEPSLEEP\n");
-                } else {
-                    printf("Unknown\n");
-                }
-            } else if (POWER_CONTROLLER_ERROR_UNAVAILABLE == res) {
-                printf("Error :: PowerManager plugin unavailable\n");
-            } else {
-                printf("Error :: Unknown\n");
-            }
+            queryPowerController();
+        } else if (argv[1] && strlen(argv[1]) > 1 && argv[1][1] == 's') {
+            PowerStateShm_Snapshot_t snapshot;
+            const PowerStateShm_t* shm = PowerStateShm_Map();
 
-            /* Dispose closes RPC conn, do not make any power manager calls after this */
-            PowerController_Term();
+            /* A segment left behind by a monitor that died holds a stale state */
+            if ((shm != NULL) && !PowerStateShm_PublisherAlive(shm)) {
+                PowerStateShm_Unmap(shm);
+                shm = NULL;
+            }
+            if (shm != NULL) {
+                PowerStateShm_Read(shm, &snapshot);
+                PowerStateShm_Unmap(shm);
+            }
+            /* The monitor creates the segment before PowerController is up
+               and publishes the first state only once it is */
+            if ((shm == NULL) || (snapshot.changedMonotonicNs == 0)) {
+                fprintf(stderr, "pwr-state-monitor is not publishing the power state, asking PowerManager\n");
+                queryPowerController();
+                return 0;
+            }
 
+            printf("%s\n", stateName((PowerController_PowerState_t)snapshot.currentState));
         } else if (argv[1] && strlen(argv[1]) > 1 && argv[1][1] == 'h') {
             usage();
         }
     } else {
-        PWRMgr_Settings_t pwrSettings;
-        const char* settingsFile = "/opt/uimgr_settings.bin";
-
-        int fd = open(settingsFile, O_RDONLY);
+        UimgrSettings_t settings;
 
-        memset(&pwrSettings, 0, sizeof(PWRMgr_Settings_t));
-
-        if (fd > 0) {
-            // Copilot fix: Added lseek error handling and ensured fd is closed in all paths
-            // to prevent resource leak
-            off_t seek_result = lseek(fd, 0, SEEK_SET);
-            if (seek_result < 0) {
-                printf("Error in seeking PWRMgr settings File\n");
-            } else {
-                ret = read(fd, &pwrSettings, (sizeof(PWRMgr_Settings_t) - PADDING_SIZE));
-            }
-
-            close(fd);
-        }
-
-        if (ret > 0) {
-            if (PWRMGR_POWERSTATE_OFF == pwrSettings.powerState) {
-                printf("OFF");
-            } else if (PWRMGR_POWERSTATE_STANDBY == pwrSettings.powerState) {
-                printf("STANDBY");
-            } else if (PWRMGR_POWERSTATE_ON == pwrSettings.powerState) {
-                printf("ON");
-            } else if (PWRMGR_POWERSTATE_STANDBY_LIGHT_SLEEP == pwrSettings.powerState) {
-                printf("LIGHTSLEEP");
-            } else if (PWRMGR_POWERSTATE_STANDBY_DEEP_SLEEP == pwrSettings.powerState) {
-                printf("DEEPSLEEP");
-            } else {
-                printf("Unknown Power state");
-            }
+        if (UimgrSettings_Read(UIMGR_SETTINGS_FILE, UIMGR_SETTINGS_CACHE, &settings) == UIMGR_SETTINGS_OK) {
+            printf("%s", settingsStateName(settings.powerState));
         } else {
             printf("Error in reading PWRMgr settings File");
         }
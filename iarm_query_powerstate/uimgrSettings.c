@@ -0,0 +1,207 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uimgrSettings.h"
+
+#define CACHE_MAGIC 0x43535055 /* "UPSC" */
+#define CACHE_VERSION 1
+#define MIN_SETTINGS_SIZE (UIMGR_SETTINGS_OFFSET_POWER_STATE + 4)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtimeSec, mtimeNsec;
+    int64_t ctimeSec, ctimeNsec;
+    UimgrSettings_t settings;
+} CacheEntry;
+
+static uint32_t getWord(const uint8_t* buf, size_t offset)
+{
+    uint32_t value;
+    memcpy(&value, buf + offset, sizeof(value));
+    return value;
+}
+
+static void fillKey(CacheEntry* entry, const struct stat* st)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->magic = CACHE_MAGIC;
+    entry->version = CACHE_VERSION;
+    entry->dev = (uint64_t)st->st_dev;
+    entry->ino = (uint64_t)st->st_ino;
+    entry->size = (uint64_t)st->st_size;
+    entry->mtimeSec = st->st_mtim.tv_sec;
+    entry->mtimeNsec = st->st_mtim.tv_nsec;
+    entry->ctimeSec = st->st_ctim.tv_sec;
+    entry->ctimeNsec = st->st_ctim.tv_nsec;
+}
+
+static int readCache(const char* cachePath, const CacheEntry* key, UimgrSettings_t* settings)
+{
+    CacheEntry entry;
+    struct stat st;
+    int fd = open(cachePath, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    ssize_t len;
+
+    if (fd < 0) {
+        return -1;
+    }
+    /* /tmp is shared, only trust a cache this user wrote */
+    if ((fstat(fd, &st) != 0) || (st.st_uid != geteuid()) || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return -1;
+    }
+    len = read(fd, &entry, sizeof(entry));
+    close(fd);
+    if ((len != (ssize_t)sizeof(entry)) || (memcmp(&entry, key, offsetof(CacheEntry, settings)) != 0)) {
+        return -1;
+    }
+    *settings = entry.settings;
+    return 0;
+}
+
+static void writeCache(const char* cachePath, CacheEntry* entry, const UimgrSettings_t* settings)
+{
+    char tmpPath[256];
+    struct timespec now;
+    int fd;
+
+    /* A rewrite within the timestamp granularity would keep the same key,
+       only cache a file that has not changed for a while */
+    clock_gettime(CLOCK_REALTIME, &now);
+    if ((now.tv_sec - entry->mtimeSec < 2) || (now.tv_sec - entry->ctimeSec < 2)) {
+        return;
+    }
+
+    entry->settings = *settings;
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d", cachePath, (int)getpid());
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    if (write(fd, entry, sizeof(*entry)) != (ssize_t)sizeof(*entry)) {
+        close(fd);
+        unlink(tmpPath);
+        return;
+    }
+    close(fd);
+    if (rename(tmpPath, cachePath) != 0) {
+        unlink(tmpPath);
+    }
+}
+
+static UimgrSettings_Status_t parse(const uint8_t* buf, size_t size, UimgrSettings_t* settings)
+{
+    uint32_t length;
+
+    if (size < MIN_SETTINGS_SIZE) {
+        return UIMGR_SETTINGS_TRUNCATED;
+    }
+    if (getWord(buf, 0) != UIMGR_SETTINGS_MAGIC) {
+        return UIMGR_SETTINGS_BAD_MAGIC;
+    }
+    length = getWord(buf, UIMGR_SETTINGS_OFFSET_LENGTH);
+    if (length == 0) {
+        length = (uint32_t)size;
+    }
+    if ((length < MIN_SETTINGS_SIZE) || (length > size)) {
+        return UIMGR_SETTINGS_BAD_LENGTH;
+    }
+
+    memset(settings, 0, sizeof(*settings));
+    settings->version = getWord(buf, UIMGR_SETTINGS_OFFSET_VERSION);
+    settings->length = length;
+    settings->powerState = (PWRMgr_PowerState_t)getWord(buf, UIMGR_SETTINGS_OFFSET_POWER_STATE);
+    if ((uint32_t)settings->powerState >= PWRMGR_POWERSTATE_MAX) {
+        return UIMGR_SETTINGS_BAD_POWER_STATE;
+    }
+    if (length >= UIMGR_SETTINGS_OFFSET_LED_COLOR + 4) {
+        settings->ledBrightness = getWord(buf, UIMGR_SETTINGS_OFFSET_LED_BRIGHTNESS);
+        settings->ledColor = getWord(buf, UIMGR_SETTINGS_OFFSET_LED_COLOR);
+        settings->fields |= UIMGR_SETTINGS_HAS_LED;
+    }
+    if (length >= UIMGR_SETTINGS_OFFSET_DEEP_SLEEP_TIMEOUT + 4) {
+        settings->deepSleepTimeout = getWord(buf, UIMGR_SETTINGS_OFFSET_DEEP_SLEEP_TIMEOUT);
+        settings->fields |= UIMGR_SETTINGS_HAS_DEEP_SLEEP_TIMEOUT;
+    }
+    return UIMGR_SETTINGS_OK;
+}
+
+UimgrSettings_Status_t UimgrSettings_Read(const char* path, const char* cachePath, UimgrSettings_t* settings)
+{
+    uint8_t buf[UIMGR_SETTINGS_MAX_SIZE];
+    UimgrSettings_Status_t status;
+    CacheEntry key;
+    struct stat st;
+    ssize_t len;
+    int fd;
+
+    if ((cachePath != NULL) && (stat(path, &st) == 0)) {
+        fillKey(&key, &st);
+        if (readCache(cachePath, &key, settings) == 0) {
+            return UIMGR_SETTINGS_OK;
+        }
+    }
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return UIMGR_SETTINGS_NOT_READABLE;
+    }
+    /* The file is a few dozen bytes, one pread takes all of it */
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return UIMGR_SETTINGS_NOT_READABLE;
+    }
+    len = pread(fd, buf, sizeof(buf), 0);
+    close(fd);
+    if (len < 0) {
+        return UIMGR_SETTINGS_NOT_READABLE;
+    }
+
+    status = parse(buf, (size_t)len, settings);
+    if ((status == UIMGR_SETTINGS_OK) && (cachePath != NULL) && ((off_t)len == st.st_size)) {
+        fillKey(&key, &st);
+        writeCache(cachePath, &key, settings);
+    }
+    return status;
+}
+
+const char* UimgrSettings_StatusText(UimgrSettings_Status_t status)
+{
+    switch (status) {
+    case UIMGR_SETTINGS_OK: return "OK";
+    case UIMGR_SETTINGS_NOT_READABLE: return "not readable";
+    case UIMGR_SETTINGS_TRUNCATED: return "truncated";
+    case UIMGR_SETTINGS_BAD_MAGIC: return "bad magic";
+    case UIMGR_SETTINGS_BAD_LENGTH: return "length does not match the file";
+    case UIMGR_SETTINGS_BAD_POWER_STATE: return "power state out of range";
+    default: return "unknown error";
+    }
+}
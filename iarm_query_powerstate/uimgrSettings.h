@@ -0,0 +1,98 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Validated reader of the power manager settings file.
+ *
+ * The file starts with magic, version and length, followed by the settings
+ * in the order they were added. Writers of every version only ever append
+ * fields, so a field is taken from the file when length covers it, whatever
+ * the version number. Files from writers that left length at 0 are read up
+ * to their size.
+ *
+ * The parsed settings are cached in tmpfs keyed on the device, inode, size,
+ * mtime and ctime of the file, so repeated queries only cost a stat.
+ */
+#ifndef _UIMGR_SETTINGS_H_
+#define _UIMGR_SETTINGS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UIMGR_SETTINGS_FILE "/opt/uimgr_settings.bin"
+#define UIMGR_SETTINGS_CACHE "/tmp/.uimgr_settings.cache"
+#define UIMGR_SETTINGS_MAGIC 0xFEBEEFAC
+
+/**
+ * @brief All possible power states
+*/
+typedef enum _Daemon_PowerState_t
+{
+    PWRMGR_POWERSTATE_OFF,                  /*!< Power state OFF */
+    PWRMGR_POWERSTATE_STANDBY,              /*!< Power state STANDBY */
+    PWRMGR_POWERSTATE_ON,                   /*!< Power state ON */
+    PWRMGR_POWERSTATE_STANDBY_LIGHT_SLEEP,  /*!< Power state Standby Light Sleep */
+    PWRMGR_POWERSTATE_STANDBY_DEEP_SLEEP,   /*!< Power state DeepSleep power saving mode */
+    PWRMGR_POWERSTATE_MAX                   /*!< Out of range - required to be the last item of the enum */
+} PWRMgr_PowerState_t;
+
+/* On-disk offsets, each field is a 32 bit word */
+#define UIMGR_SETTINGS_OFFSET_VERSION 4
+#define UIMGR_SETTINGS_OFFSET_LENGTH 8
+#define UIMGR_SETTINGS_OFFSET_POWER_STATE 12
+#define UIMGR_SETTINGS_OFFSET_LED_BRIGHTNESS 16
+#define UIMGR_SETTINGS_OFFSET_LED_COLOR 20
+#define UIMGR_SETTINGS_OFFSET_DEEP_SLEEP_TIMEOUT 24
+#define UIMGR_SETTINGS_MAX_SIZE 4096
+
+/* UimgrSettings_t.fields */
+#define UIMGR_SETTINGS_HAS_LED (1u << 0)
+#define UIMGR_SETTINGS_HAS_DEEP_SLEEP_TIMEOUT (1u << 1)
+
+typedef struct _UimgrSettings_t {
+    uint32_t version;
+    uint32_t length;                /*!< Bytes of settings, as read from the file or its size */
+    uint32_t fields;                /*!< UIMGR_SETTINGS_HAS_* present in the file */
+    PWRMgr_PowerState_t powerState;
+    uint32_t ledBrightness;
+    uint32_t ledColor;
+    uint32_t deepSleepTimeout;
+} UimgrSettings_t;
+
+typedef enum _UimgrSettings_Status_t {
+    UIMGR_SETTINGS_OK = 0,
+    UIMGR_SETTINGS_NOT_READABLE,    /*!< Missing or no permission */
+    UIMGR_SETTINGS_TRUNCATED,       /*!< Shorter than the header and power state */
+    UIMGR_SETTINGS_BAD_MAGIC,
+    UIMGR_SETTINGS_BAD_LENGTH,      /*!< length says more than the file holds */
+    UIMGR_SETTINGS_BAD_POWER_STATE,
+} UimgrSettings_Status_t;
+
+/* Read and validate path, through the cache unless cachePath is NULL */
+UimgrSettings_Status_t UimgrSettings_Read(const char* path, const char* cachePath, UimgrSettings_t* settings);
+
+const char* UimgrSettings_StatusText(UimgrSettings_Status_t status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UIMGR_SETTINGS_H_ */
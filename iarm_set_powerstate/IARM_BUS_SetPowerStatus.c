@@ -16,16 +16,25 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <errno.h>
 #include <getopt.h>
+#include <poll.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <sys/eventfd.h>
 
 #include "power_controller.h"
+#include "powerConnect.h"
+#include "ackScheduler.h"
+#include "pendingQueue.h"
+#include "powerCycleSoak.h"
+#include "preChangeStress.h"
 
 #define ARRAY_SIZE 10
 
@@ -51,6 +60,17 @@ static void usage()
     printf("\t  --delay <D1,D2,D3>       Delay for power change in seconds, as CSV (default: no delay).\n");
     printf("\t                           Each delay corresponds to `DelayPowerModeChangeBy` call\n");
     printf("\t  --await <SECONDS>        Wait at least this many seconds before exiting (default 0).\n");
+    printf("\t  --lead <MS>              Send delayed acks and delay extensions this early, to beat the running timeout (default 50).\n");
+    printf("\n\tPre-change stress mode, goes to the given state and back:\n");
+    printf("\t  --clients <N1,N2,...>    Register N pre-change clients from this process, for each count in turn.\n");
+    printf("\t  --profile <P1,P2,...>    Client ack profiles, assigned round robin (default: fixed:0):\n");
+    printf("\t                           fixed:MS, random:MIN-MAX (ms) or never.\n");
+    printf("\t  --iterations <N>         Round trips per client count (default 10).\n");
+    printf("\t  --timeout <MS>           Longest wait for the mode change (default 30000).\n");
+    printf("\n\tSoak mode, no POWER_STATE needed:\n");
+    printf("\t  --cycle <S1[:MS],S2[:MS],...>  Walk these states over one connection, dwelling MS in each (default 0).\n");
+    printf("\t                           e.g. ON:1000,STANDBY,LIGHTSLEEP:5000\n");
+    printf("\t  --cycles <N>             Number of cycles, 0 until SIGINT/SIGTERM (default 0).\n");
 }
 
 static void parseCSV(const char* arg, int* values, int* size)
@@ -71,75 +91,127 @@ static void parseCSV(const char* arg, int* values, int* size)
     *size = index;
 }
 
+/*
+ * The PowerController callback only publishes: it acks right away when asked
+ * to, pushes the transaction on a lock-free queue and wakes the main thread,
+ * which plans the delayed ack and delays of every transaction it pops. So
+ * overlapping pre-change events each get their own plan and the callback
+ * thread never takes a lock.
+ */
 typedef struct {
     char clientName[256];
     int ack;
     int delay[ARRAY_SIZE];
     int delaySize;
+    int leadMs;
     uint32_t clientId;
-    volatile int transactionId;
-    pthread_t asyncThread;
+    atomic_int lastTransactionId;
+    atomic_uint received;
+    atomic_uint dropped;
+    PendingQueue_t pending;
+    int wakeFd;
 } Controller;
 
-static void* asyncThreadMain(void* arg)
-{
-    Controller* controller = (Controller*)arg;
-    // Copilot fix: Changed from floating-point to integer-only arithmetic to prevent overflow
-    usleep((controller->ack * 1000000) - 50000); // Ack delay minus 50ms
-    PowerController_PowerModePreChangeComplete(controller->clientId, controller->transactionId);
-    return NULL;
-}
-
 static void onPowerModePreChangeEvent(const PowerController_PowerState_t currentState,
                                       const PowerController_PowerState_t newState,
                                       const int transactionId, const int stateChangeAfter, void* userdata)
 {
     Controller* controller = (Controller*)userdata;
+    PendingTransaction_t transaction = { transactionId, stateChangeAfter, AckScheduler_Now() };
+    const uint64_t one = 1;
 
     printf("onPowerModePreChangeEvent currentState: %d, newState: %d, clientId: %d, transactionId: %d, stateChangeAfter: %d\n",
            currentState, newState, controller->clientId, transactionId, stateChangeAfter);
 
-    controller->transactionId = transactionId;
+    atomic_fetch_add_explicit(&controller->received, 1, memory_order_relaxed);
+    atomic_store_explicit(&controller->lastTransactionId, transactionId, memory_order_relaxed);
 
     if (controller->ack == 0) {
         PowerController_PowerModePreChangeComplete(controller->clientId, transactionId);
-    } else if (controller->ack > 0) {
-        pthread_create(&(controller->asyncThread), NULL, asyncThreadMain, controller);
+    }
+    if ((controller->ack <= 0) && (controller->delaySize == 0)) {
+        return;
+    }
+    if (PendingQueue_Push(&controller->pending, &transaction) != 0) {
+        atomic_fetch_add_explicit(&controller->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    if (write(controller->wakeFd, &one, sizeof(one)) < 0) {
+        /* Counter saturated, the main thread is awake anyway */
     }
 }
 
-static void initController(Controller* controller)
+/*
+ * Schedules the answers to one transaction at absolute times from its
+ * event: the ack after `ack` seconds, the first delay right away and every
+ * further delay when the previous one runs out. Calls that must beat a
+ * running PowerManager timeout go out leadMs before it expires. Returns -1
+ * if the scheduler was full for any of them.
+ */
+static int scheduleTransaction(Controller* controller, const PendingTransaction_t* transaction)
 {
-    PowerController_Init();
-
-    while (!PowerController_IsOperational()) {
-        uint32_t status = PowerController_Connect();
+    uint64_t leadNs = (uint64_t)controller->leadMs * 1000000ULL;
+    uint64_t dueNs = transaction->receivedNs;
+    int status = 0;
+
+    if (controller->ack > 0) {
+        uint64_t ackNs = (uint64_t)controller->ack * 1000000000ULL;
+        if (AckScheduler_Add(ACK_SCHEDULER_ACK, controller->clientId, transaction->transactionId, 0,
+                             transaction->receivedNs, transaction->receivedNs + ((ackNs > leadNs) ? (ackNs - leadNs) : 0)) != 0) {
+            status = -1;
+        }
+    }
 
-        if (POWER_CONTROLLER_ERROR_NONE == status) {
-            printf("\nSuccess :: Connect\n");
-            break;
-        } else if (POWER_CONTROLLER_ERROR_UNAVAILABLE == status) {
-            printf("\nFailed :: Connect :: Thunder is UNAVAILABLE\n");
-        } else if (POWER_CONTROLLER_ERROR_NOT_EXIST == status) {
-            printf("\nFailed :: Connect :: PowerManager is UNAVAILABLE\n");
-        } else {
-            // Do nothing
+    for (int i = 0; i < controller->delaySize; i++) {
+        if (controller->delay[i] <= 0) {
+            continue;
         }
-        usleep(100 * 1000); // 100ms
+        if (AckScheduler_Add(ACK_SCHEDULER_DELAY, controller->clientId, transaction->transactionId, controller->delay[i],
+                             transaction->receivedNs, dueNs) != 0) {
+            status = -1;
+        }
+        dueNs += (uint64_t)controller->delay[i] * 1000000000ULL;
+        dueNs = (dueNs - leadNs > transaction->receivedNs) ? (dueNs - leadNs) : transaction->receivedNs;
+    }
+    return status;
+}
+
+/* Returns -1 if the wake eventfd or the scheduler could not be set up */
+static int initController(Controller* controller)
+{
+    PowerConnect_Stats_t stats;
+
+    atomic_init(&controller->lastTransactionId, 0);
+    atomic_init(&controller->received, 0);
+    atomic_init(&controller->dropped, 0);
+    PendingQueue_Init(&controller->pending);
+    controller->wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (controller->wakeFd < 0) {
+        printf("Not able to create the wake eventfd (%s)\n", strerror(errno));
+        return -1;
+    }
+    if (AckScheduler_Start(true) != 0) {
+        close(controller->wakeFd);
+        return -1;
     }
 
+    PowerController_Init();
+
+    PowerConnect_Wait(0, &stats);
+    printf("PowerController operational after %llu ms (%u connect attempts, %u notifications)\n",
+           (unsigned long long)(stats.elapsedUs / 1000), stats.attempts, stats.notifications);
+
     PowerController_RegisterPowerModePreChangeCallback(onPowerModePreChangeEvent, controller);
 
     if (strlen(controller->clientName) > 0) {
         PowerController_AddPowerModePreChangeClient(controller->clientName, &(controller->clientId));
     }
+    return 0;
 }
 
 static void terminateController(Controller* controller)
 {
-    if (controller->asyncThread) {
-        pthread_join(controller->asyncThread, NULL);
-    }
+    unsigned int dropped;
 
     if (strlen(controller->clientName) > 0) {
         PowerController_RemovePowerModePreChangeClient(controller->clientId);
@@ -147,24 +219,59 @@ static void terminateController(Controller* controller)
 
     PowerController_UnRegisterPowerModePreChangeCallback(onPowerModePreChangeEvent);
 
+    AckScheduler_Stop();
+
     PowerController_Term();
+
+    dropped = atomic_load(&controller->dropped);
+    if (dropped > 0) {
+        printf("%u of %u pre-change events not fully answered, more than %d transactions or %d calls pending\n",
+               dropped, atomic_load(&controller->received), PENDING_QUEUE_SIZE, ACK_SCHEDULER_MAX_ACTIONS);
+    }
+    close(controller->wakeFd);
 }
 
-static void runDelay(Controller* controller)
+/*
+ * Plans every pre-change transaction as it arrives until the scheduled
+ * calls have gone out and `await` seconds have passed. When this client
+ * answers pre-changes, PowerManager gets 500ms to send the first one.
+ */
+static void runSchedule(Controller* controller, int await)
 {
-    int retry = 5;
+    int answers = (controller->ack > 0) || (controller->delaySize > 0);
+    uint64_t startNs = AckScheduler_Now();
+    uint64_t firstDeadlineNs = startNs + (answers ? 500000000ULL : 0);
+    uint64_t awaitEndNs = startNs + ((uint64_t)await * 1000000000ULL);
+    struct pollfd fds[2] = { { controller->wakeFd, POLLIN, 0 }, { AckScheduler_IdleFd(), POLLIN, 0 } };
+
+    for (;;) {
+        PendingTransaction_t transaction;
+        uint64_t count, nowNs;
+        int timeoutMs;
+
+        while (PendingQueue_Pop(&controller->pending, &transaction) == 0) {
+            if (scheduleTransaction(controller, &transaction) != 0) {
+                atomic_fetch_add_explicit(&controller->dropped, 1, memory_order_relaxed);
+            }
+        }
 
-    // Wait for PowerManager to respond
-    // `transactionId` will be updated on receiving onPowerModePreChangeEvent
-    while (controller->transactionId == 0 && retry-- > 0) {
-        usleep(100 * 1000); // 100ms
-    }
+        nowNs = AckScheduler_Now();
+        if ((atomic_load_explicit(&controller->lastTransactionId, memory_order_relaxed) == 0) && (nowNs < firstDeadlineNs)) {
+            timeoutMs = (int)((firstDeadlineNs - nowNs + 999999) / 1000000);
+        } else if (nowNs < awaitEndNs) {
+            timeoutMs = (int)((awaitEndNs - nowNs + 999999) / 1000000);
+        } else if (AckScheduler_Pending() > 0) {
+            timeoutMs = -1;
+        } else {
+            break;
+        }
 
-    if (controller->transactionId > 0) {
-        for (int i = 0; i < controller->delaySize; i++) {
-            if (controller->delay[i] > 0) {
-                PowerController_DelayPowerModeChangeBy(controller->clientId, controller->transactionId, controller->delay[i]);
-                usleep((controller->delay[i] - 0.05) * 1000000); // Delay minus 50ms
+        if (poll(fds, 2, timeoutMs) > 0) {
+            if ((fds[0].revents & POLLIN) && (read(controller->wakeFd, &count, sizeof(count)) < 0)) {
+                /* Drained by an earlier read */
+            }
+            if ((fds[1].revents & POLLIN) && (read(fds[1].fd, &count, sizeof(count)) < 0)) {
+                /* Drained by an earlier read */
             }
         }
     }
@@ -182,17 +289,28 @@ int main(int argc, char* argv[])
         { "ack", required_argument, NULL, 'a' },
         { "delay", required_argument, NULL, 'd' },
         { "await", required_argument, NULL, 'w' },
+        { "clients", required_argument, NULL, 'n' },
+        { "profile", required_argument, NULL, 'p' },
+        { "iterations", required_argument, NULL, 'i' },
+        { "timeout", required_argument, NULL, 'o' },
+        { "lead", required_argument, NULL, 'l' },
+        { "cycle", required_argument, NULL, 'C' },
+        { "cycles", required_argument, NULL, 'N' },
         { NULL, 0, NULL, 0 }
     };
+    PreChangeStress_Config_t stress = { .clientCountSize = 0, .profileCount = 1,
+                                        .profiles = { { STRESS_ACK_FIXED, 0, 0 } },
+                                        .iterations = 10, .timeoutMs = 30000 };
+    PowerCycleSoak_Config_t soak = { .stepCount = 0, .cycles = 0 };
 
-    Controller controller = { .clientName = "", .ack = -1, .delaySize = 0, .clientId = 0, .transactionId = 0 };
+    Controller controller = { .clientName = "", .ack = -1, .delaySize = 0, .leadMs = 50, .clientId = 0 };
 
     int await = 0;
     char argstate[256] = "";
 
     int opt;
     int optionIndex = 0;
-    while ((opt = getopt_long(argc, argv, "c:a:d:w:", longOptions, &optionIndex)) != -1) {
+    while ((opt = getopt_long(argc, argv, "c:a:d:w:n:p:i:o:l:C:N:", longOptions, &optionIndex)) != -1) {
         switch (opt) {
         case 'c':
             strncpy(controller.clientName, optarg, sizeof(controller.clientName) - 1);
@@ -206,12 +324,46 @@ int main(int argc, char* argv[])
         case 'w':
             await = atoi(optarg);
             break;
+        case 'n':
+            parseCSV(optarg, stress.clientCounts, &stress.clientCountSize);
+            break;
+        case 'p':
+            if (PreChangeStress_ParseProfiles(optarg, &stress) != 0) {
+                fprintf(stderr, "Error: invalid profile '%s'.\n", optarg);
+                usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'i':
+            stress.iterations = atoi(optarg);
+            break;
+        case 'o':
+            stress.timeoutMs = atoi(optarg);
+            break;
+        case 'l':
+            controller.leadMs = atoi(optarg);
+            break;
+        case 'C':
+            if (PowerCycleSoak_ParseSteps(optarg, &soak) != 0) {
+                fprintf(stderr, "Error: invalid cycle '%s', needs at least two states.\n", optarg);
+                usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'N':
+            soak.cycles = atoi(optarg);
+            break;
         default:
             usage();
             return EXIT_FAILURE;
         }
     }
 
+    if (soak.stepCount > 0) {
+        soak.timeoutMs = stress.timeoutMs;
+        return (PowerCycleSoak_Run(&soak) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     if (optind < argc) {
         strncpy(argstate, argv[optind], sizeof(argstate) - 1);
     } else {
@@ -243,7 +395,24 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-    initController(&controller);
+    if (stress.clientCountSize > 0) {
+        if ((powerstate == POWER_STATE_UNKNOWN) || (stress.iterations <= 0)) {
+            usage();
+            return EXIT_FAILURE;
+        }
+        for (int i = 0; i < stress.clientCountSize; i++) {
+            if ((stress.clientCounts[i] < 0) || (stress.clientCounts[i] > STRESS_MAX_CLIENTS)) {
+                fprintf(stderr, "Error: client count must be 0..%d.\n", STRESS_MAX_CLIENTS);
+                return EXIT_FAILURE;
+            }
+        }
+        stress.target = powerstate;
+        return (PreChangeStress_Run(&stress) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (initController(&controller) != 0) {
+        return EXIT_FAILURE;
+    }
 
     // Wait for parallel `SetPowerState` run
     usleep(100 * 1000);
@@ -260,11 +429,7 @@ int main(int argc, char* argv[])
         }
     }
 
-    runDelay(&controller);
-
-    if (await > 0) {
-        sleep(await);
-    }
+    runSchedule(&controller, await);
 
     terminateController(&controller);
 
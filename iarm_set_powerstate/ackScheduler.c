@@ -0,0 +1,290 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "power_controller.h"
+#include "ackScheduler.h"
+
+typedef struct {
+    AckScheduler_Action_t action;
+    uint32_t clientId;
+    int transactionId;
+    int delaySec;
+    uint64_t baseNs;
+    uint64_t dueNs;
+} Action;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t idleCond;
+static pthread_t thread;
+static int running = 0;
+static bool verbose = false;
+static int stopping = 0;
+static int timerFd = -1;
+static int wakeFd = -1;
+static int idleFd = -1;
+
+/* Sorted on dueNs, earliest first */
+static Action actions[ACK_SCHEDULER_MAX_ACTIONS];
+static int actionCount = 0;
+static int firing = 0;
+
+/* Lateness of the calls made so far */
+static uint32_t firedCount = 0;
+static uint64_t lateTotalNs = 0;
+static uint64_t lateMaxNs = 0;
+
+uint64_t AckScheduler_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* Called with lock held: arm for the earliest action, or disarm */
+static void armTimer(void)
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    if (actionCount > 0) {
+        /* A zero it_value disarms, an action due at 0 must still fire */
+        uint64_t due = actions[0].dueNs ? actions[0].dueNs : 1;
+        its.it_value.tv_sec = (time_t)(due / 1000000000ULL);
+        its.it_value.tv_nsec = (long)(due % 1000000000ULL);
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+static void fire(const Action* action)
+{
+    uint64_t firedNs = AckScheduler_Now();
+    uint64_t lateNs = (firedNs > action->dueNs) ? (firedNs - action->dueNs) : 0;
+    uint32_t status;
+
+    if (action->action == ACK_SCHEDULER_ACK) {
+        status = PowerController_PowerModePreChangeComplete(action->clientId, action->transactionId);
+    } else {
+        status = PowerController_DelayPowerModeChangeBy(action->clientId, action->transactionId, action->delaySec);
+    }
+
+    if (verbose) {
+        printf("%s transactionId: %d intended: +%.3f ms actual: +%.3f ms late: %.3f ms%s\n",
+               (action->action == ACK_SCHEDULER_ACK) ? "PreChangeComplete" : "DelayPowerModeChangeBy",
+               action->transactionId, (action->dueNs - action->baseNs) / 1e6, (firedNs - action->baseNs) / 1e6,
+               lateNs / 1e6, (status == POWER_CONTROLLER_ERROR_NONE) ? "" : " (failed)");
+    }
+
+    pthread_mutex_lock(&lock);
+    firedCount++;
+    lateTotalNs += lateNs;
+    if (lateNs > lateMaxNs) {
+        lateMaxNs = lateNs;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void* schedulerMain(void* arg)
+{
+    struct pollfd fds[2] = { { timerFd, POLLIN, 0 }, { wakeFd, POLLIN, 0 } };
+    uint64_t count;
+
+    pthread_mutex_lock(&lock);
+    while (!stopping) {
+        pthread_mutex_unlock(&lock);
+        if ((poll(fds, 2, -1) < 0) && (errno != EINTR)) {
+            printf("AckScheduler: poll failed (%s)\n", strerror(errno));
+            pthread_mutex_lock(&lock);
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            if (read(timerFd, &count, sizeof(count)) < 0) {
+                /* Re-armed meanwhile, nothing expired */
+            }
+        }
+        if (fds[1].revents & POLLIN) {
+            if (read(wakeFd, &count, sizeof(count)) < 0) {
+                /* Nothing to drain */
+            }
+        }
+
+        pthread_mutex_lock(&lock);
+        while (!stopping && (actionCount > 0) && (actions[0].dueNs <= AckScheduler_Now())) {
+            Action action = actions[0];
+
+            memmove(&actions[0], &actions[1], (size_t)(--actionCount) * sizeof(Action));
+            firing = 1;
+            pthread_mutex_unlock(&lock);
+            fire(&action);
+            pthread_mutex_lock(&lock);
+            firing = 0;
+        }
+        armTimer();
+        if ((actionCount == 0) && !firing) {
+            const uint64_t one = 1;
+
+            pthread_cond_broadcast(&idleCond);
+            if (write(idleFd, &one, sizeof(one)) < 0) {
+                /* Nobody drained it yet, still readable */
+            }
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+int AckScheduler_Start(bool logCalls)
+{
+    pthread_condattr_t attr;
+
+    if (running) {
+        return 0;
+    }
+    verbose = logCalls;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&idleCond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    idleFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((timerFd < 0) || (wakeFd < 0) || (idleFd < 0)) {
+        printf("AckScheduler_Start: Not able to create the timer (%s)\n", strerror(errno));
+        AckScheduler_Stop();
+        return -1;
+    }
+    stopping = 0;
+    actionCount = 0;
+    if (pthread_create(&thread, NULL, schedulerMain, NULL) != 0) {
+        printf("AckScheduler_Start: Not able to start the thread\n");
+        AckScheduler_Stop();
+        return -1;
+    }
+    running = 1;
+    return 0;
+}
+
+int AckScheduler_Add(AckScheduler_Action_t action, uint32_t clientId, int transactionId, int delaySec,
+                     uint64_t baseNs, uint64_t dueNs)
+{
+    const uint64_t one = 1;
+    int i;
+
+    pthread_mutex_lock(&lock);
+    if (!running || (actionCount == ACK_SCHEDULER_MAX_ACTIONS)) {
+        pthread_mutex_unlock(&lock);
+        printf("AckScheduler_Add: Not able to schedule transactionId %d\n", transactionId);
+        return -1;
+    }
+    for (i = actionCount; (i > 0) && (actions[i - 1].dueNs > dueNs); i--) {
+        actions[i] = actions[i - 1];
+    }
+    actions[i].action = action;
+    actions[i].clientId = clientId;
+    actions[i].transactionId = transactionId;
+    actions[i].delaySec = delaySec;
+    actions[i].baseNs = baseNs;
+    actions[i].dueNs = dueNs;
+    actionCount++;
+    if (i == 0) {
+        armTimer();
+    }
+    pthread_mutex_unlock(&lock);
+
+    /* The thread may be between poll and the lock, make sure it looks again */
+    if (write(wakeFd, &one, sizeof(one)) < 0) {
+        /* Counter saturated, the thread is awake anyway */
+    }
+    return 0;
+}
+
+int AckScheduler_WaitIdle(uint32_t timeoutMs)
+{
+    uint64_t deadlineNs = AckScheduler_Now() + ((uint64_t)timeoutMs * 1000000ULL);
+    struct timespec deadline = { (time_t)(deadlineNs / 1000000000ULL), (long)(deadlineNs % 1000000000ULL) };
+    int idle;
+
+    pthread_mutex_lock(&lock);
+    while (running && ((actionCount > 0) || firing) &&
+           (pthread_cond_timedwait(&idleCond, &lock, &deadline) != ETIMEDOUT)) {
+    }
+    idle = (actionCount == 0) && !firing;
+    pthread_mutex_unlock(&lock);
+    return idle ? 0 : -1;
+}
+
+int AckScheduler_Pending(void)
+{
+    int pending;
+
+    pthread_mutex_lock(&lock);
+    pending = actionCount + firing;
+    pthread_mutex_unlock(&lock);
+    return pending;
+}
+
+int AckScheduler_IdleFd(void)
+{
+    return idleFd;
+}
+
+void AckScheduler_Stop(void)
+{
+    const uint64_t one = 1;
+
+    if (running) {
+        pthread_mutex_lock(&lock);
+        stopping = 1;
+        if (actionCount > 0) {
+            printf("AckScheduler: %d scheduled calls dropped\n", actionCount);
+            actionCount = 0;
+        }
+        pthread_mutex_unlock(&lock);
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            /* The thread is awake anyway */
+        }
+        pthread_join(thread, NULL);
+        running = 0;
+    }
+    if (firedCount > 0) {
+        printf("AckScheduler: %u calls, late by %.3f ms on average, %.3f ms at most\n",
+               firedCount, (lateTotalNs / firedCount) / 1e6, lateMaxNs / 1e6);
+    }
+    if (timerFd >= 0) {
+        close(timerFd);
+        timerFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+    if (idleFd >= 0) {
+        close(idleFd);
+        idleFd = -1;
+    }
+}
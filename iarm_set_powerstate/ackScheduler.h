@@ -0,0 +1,72 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Pre-change ack and delay scheduler of SetPowerState.
+ *
+ * One thread and one absolute CLOCK_MONOTONIC timerfd fire every
+ * PowerModePreChangeComplete and DelayPowerModeChangeBy call at its
+ * deadline, and record how late each one actually went out.
+ */
+#ifndef _ACK_SCHEDULER_H_
+#define _ACK_SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ACK_SCHEDULER_MAX_ACTIONS 256
+
+typedef enum _AckScheduler_Action_t {
+    ACK_SCHEDULER_ACK,      /*!< PowerController_PowerModePreChangeComplete */
+    ACK_SCHEDULER_DELAY,    /*!< PowerController_DelayPowerModeChangeBy */
+} AckScheduler_Action_t;
+
+/* CLOCK_MONOTONIC in ns, the time base of all deadlines */
+uint64_t AckScheduler_Now(void);
+
+/* logCalls prints every call with its intended and actual time, the
+   lateness summary of AckScheduler_Stop is printed either way */
+int AckScheduler_Start(bool logCalls);
+
+/* Fire action at dueNs. baseNs is the pre-change event it belongs to, only
+   used to report times relative to it. Returns 0 on success */
+int AckScheduler_Add(AckScheduler_Action_t action, uint32_t clientId, int transactionId, int delaySec,
+                     uint64_t baseNs, uint64_t dueNs);
+
+/* Wait until nothing is pending, at most timeoutMs. Returns 0 once idle */
+int AckScheduler_WaitIdle(uint32_t timeoutMs);
+
+/* Calls queued or being made right now */
+int AckScheduler_Pending(void);
+
+/* eventfd that becomes readable whenever the scheduler goes idle, for
+   callers that wait on other fds as well */
+int AckScheduler_IdleFd(void);
+
+/* Drop what is still pending, stop the thread and print the lateness summary */
+void AckScheduler_Stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ACK_SCHEDULER_H_ */
@@ -0,0 +1,55 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Latency percentiles shared by the SetPowerState benchmark modes.
+ */
+#ifndef _LATENCY_STATS_H_
+#define _LATENCY_STATS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline int LatencyStats_Compare(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorts values (ns) and prints " min p50 p90 p99 max" in ms, dashes if empty */
+static inline void LatencyStats_Print(uint64_t* values, size_t count)
+{
+    if (count == 0) {
+        printf(" %9s %9s %9s %9s %9s", "-", "-", "-", "-", "-");
+        return;
+    }
+    qsort(values, count, sizeof(uint64_t), LatencyStats_Compare);
+    printf(" %9.1f %9.1f %9.1f %9.1f %9.1f", values[0] / 1e6, values[(count - 1) / 2] / 1e6,
+           values[((count - 1) * 9) / 10] / 1e6, values[((count - 1) * 99) / 100] / 1e6, values[count - 1] / 1e6);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LATENCY_STATS_H_ */
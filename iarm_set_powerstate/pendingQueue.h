@@ -0,0 +1,110 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Bounded lock-free queue of pre-change transactions waiting to be
+ * scheduled: any number of PowerController callback threads push, the
+ * main thread pops. Each slot carries a sequence number telling whose
+ * turn it is (producer when seq == position, consumer when seq ==
+ * position + 1), so neither side ever blocks; a full queue makes the
+ * push fail instead.
+ */
+#ifndef _PENDING_QUEUE_H_
+#define _PENDING_QUEUE_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PENDING_QUEUE_SIZE 64 /* Power of two */
+
+typedef struct _PendingTransaction_t {
+    int transactionId;
+    int stateChangeAfter;
+    uint64_t receivedNs;        /*!< CLOCK_MONOTONIC, deadlines are relative to it */
+} PendingTransaction_t;
+
+typedef struct _PendingQueue_t {
+    struct {
+        atomic_size_t seq;
+        PendingTransaction_t transaction;
+    } slots[PENDING_QUEUE_SIZE];
+    atomic_size_t head;         /*!< Next position to push */
+    size_t tail;                /*!< Next position to pop, consumer only */
+} PendingQueue_t;
+
+static inline void PendingQueue_Init(PendingQueue_t* queue)
+{
+    for (size_t i = 0; i < PENDING_QUEUE_SIZE; i++) {
+        atomic_init(&queue->slots[i].seq, i);
+    }
+    atomic_init(&queue->head, 0);
+    queue->tail = 0;
+}
+
+/* Returns 0 on success, -1 if the queue is full */
+static inline int PendingQueue_Push(PendingQueue_t* queue, const PendingTransaction_t* transaction)
+{
+    size_t pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(&queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            /* Our turn, claim the position unless another producer beat us to it */
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+    queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].transaction = *transaction;
+    atomic_store_explicit(&queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+/* Consumer only. Returns 0 with the oldest transaction, -1 if empty */
+static inline int PendingQueue_Pop(PendingQueue_t* queue, PendingTransaction_t* transaction)
+{
+    size_t pos = queue->tail;
+    size_t seq = atomic_load_explicit(&queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].seq, memory_order_acquire);
+
+    if (seq != pos + 1) {
+        return -1;
+    }
+    *transaction = queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].transaction;
+    /* Hand the slot back to producers one lap ahead */
+    atomic_store_explicit(&queue->slots[pos & (PENDING_QUEUE_SIZE - 1)].seq, pos + PENDING_QUEUE_SIZE, memory_order_release);
+    queue->tail = pos + 1;
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PENDING_QUEUE_H_ */
@@ -0,0 +1,320 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "latencyStats.h"
+#include "powerCycleSoak.h"
+#include "powerConnect.h"
+
+#define SOAK_MAX_STATES 6
+#define SOAK_CONNECT_TIMEOUT_MS 10000
+#define SOAK_WAIT_SLICE_MS 200  /* How quickly a signal is noticed */
+
+typedef struct {
+    uint64_t* values;       /* ns */
+    size_t count;
+    size_t size;
+    unsigned long timeouts;
+} Series;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t changedCond;
+static PowerController_PowerState_t awaitedState = POWER_STATE_UNKNOWN;
+static uint64_t changedNs = 0;
+static volatile sig_atomic_t stopRequested = 0;
+
+static Series transitions[SOAK_MAX_STATES][SOAK_MAX_STATES];
+
+static const char* stateNames[SOAK_MAX_STATES] = { "UNKNOWN", "OFF", "STANDBY", "ON", "LIGHT_SLEEP", "DEEP_SLEEP" };
+
+static const char* stateName(PowerController_PowerState_t state)
+{
+    return ((state >= 0) && (state < SOAK_MAX_STATES)) ? stateNames[state] : "?";
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void onSignal(int signo)
+{
+    stopRequested = 1;
+}
+
+static bool stopCheck(void* userdata)
+{
+    return stopRequested != 0;
+}
+
+static void addValue(Series* series, uint64_t ns)
+{
+    if (series->count == series->size) {
+        size_t size = series->size ? (series->size * 2) : 64;
+        uint64_t* values = (uint64_t*)realloc(series->values, size * sizeof(uint64_t));
+        if (values == NULL) {
+            return;
+        }
+        series->values = values;
+        series->size = size;
+    }
+    series->values[series->count++] = ns;
+}
+
+static void onChanged(const PowerController_PowerState_t currentState, const PowerController_PowerState_t newState, void* userdata)
+{
+    uint64_t receivedNs = now_ns();
+
+    pthread_mutex_lock(&lock);
+    if ((newState == awaitedState) && (changedNs == 0)) {
+        changedNs = receivedNs;
+        pthread_cond_broadcast(&changedCond);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/* Returns the SetPowerState -> PowerModeChanged latency in ns, 0 on timeout or signal */
+static uint64_t runTransition(PowerController_PowerState_t state, int timeoutMs)
+{
+    uint64_t startNs, deadlineNs, latencyNs = 0;
+    uint32_t status;
+
+    pthread_mutex_lock(&lock);
+    awaitedState = state;
+    changedNs = 0;
+    pthread_mutex_unlock(&lock);
+
+    startNs = now_ns();
+    status = PowerController_SetPowerState(0, state, "sys_mon_tool[SetPowerState soak]");
+    if (status != POWER_CONTROLLER_ERROR_NONE) {
+        printf("SetPowerState %s failed (%u)\n", stateName(state), status);
+        return 0;
+    }
+
+    deadlineNs = startNs + ((uint64_t)timeoutMs * 1000000ULL);
+    pthread_mutex_lock(&lock);
+    while ((changedNs == 0) && !stopRequested) {
+        uint64_t sliceNs = now_ns() + (SOAK_WAIT_SLICE_MS * 1000000ULL);
+        struct timespec slice;
+
+        if (sliceNs > deadlineNs) {
+            sliceNs = deadlineNs;
+        }
+        slice.tv_sec = (time_t)(sliceNs / 1000000000ULL);
+        slice.tv_nsec = (long)(sliceNs % 1000000000ULL);
+        if ((pthread_cond_timedwait(&changedCond, &lock, &slice) == ETIMEDOUT) && (sliceNs == deadlineNs)) {
+            break;
+        }
+    }
+    if (changedNs != 0) {
+        latencyNs = changedNs - startNs;
+    }
+    awaitedState = POWER_STATE_UNKNOWN;
+    pthread_mutex_unlock(&lock);
+    return latencyNs;
+}
+
+static void dwell(int ms)
+{
+    struct timespec ts = { ms / 1000, (long)(ms % 1000) * 1000000L };
+
+    while (!stopRequested && (nanosleep(&ts, &ts) != 0) && (errno == EINTR)) {
+    }
+}
+
+static PowerController_PowerState_t parseState(const char* name)
+{
+    static const struct {
+        const char* name;
+        PowerController_PowerState_t state;
+    } names[] = {
+        { "ON", POWER_STATE_ON },
+        { "STANDBY", POWER_STATE_STANDBY },
+        { "LIGHTSLEEP", POWER_STATE_STANDBY_LIGHT_SLEEP },
+        { "LIGHT_SLEEP", POWER_STATE_STANDBY_LIGHT_SLEEP },
+        { "DEEPSLEEP", POWER_STATE_STANDBY_DEEP_SLEEP },
+        { "DEEP_SLEEP", POWER_STATE_STANDBY_DEEP_SLEEP },
+        { "OFF", POWER_STATE_OFF },
+    };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcasecmp(name, names[i].name) == 0) {
+            return names[i].state;
+        }
+    }
+    return POWER_STATE_UNKNOWN;
+}
+
+int PowerCycleSoak_ParseSteps(const char* arg, PowerCycleSoak_Config_t* config)
+{
+    char buffer[256];
+    char* save = NULL;
+    char* token;
+
+    strncpy(buffer, arg, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    config->stepCount = 0;
+
+    for (token = strtok_r(buffer, ",", &save); token != NULL; token = strtok_r(NULL, ",", &save)) {
+        char* dwellMs = strchr(token, ':');
+
+        if (config->stepCount == SOAK_MAX_STEPS) {
+            return -1;
+        }
+        if (dwellMs != NULL) {
+            *dwellMs++ = '\0';
+        }
+        config->steps[config->stepCount].state = parseState(token);
+        config->steps[config->stepCount].dwellMs = (dwellMs != NULL) ? atoi(dwellMs) : 0;
+        if ((config->steps[config->stepCount].state == POWER_STATE_UNKNOWN) || (config->steps[config->stepCount].dwellMs < 0)) {
+            return -1;
+        }
+        config->stepCount++;
+    }
+    return (config->stepCount >= 2) ? 0 : -1;
+}
+
+static void printReport(unsigned long cycles, uint64_t elapsedNs)
+{
+    double hours = elapsedNs / 3.6e12;
+
+    printf("\n%lu cycles in %.1f s, %.1f cycles/hour\n\n", cycles, elapsedNs / 1e9, (hours > 0) ? (cycles / hours) : 0.0);
+    printf("%-11s    %-11s %7s %9s %9s %9s %9s %9s %8s\n", "from", "to", "count", "min", "p50", "p90", "p99", "max", "timeouts");
+    for (int from = 0; from < SOAK_MAX_STATES; from++) {
+        for (int to = 0; to < SOAK_MAX_STATES; to++) {
+            Series* series = &transitions[from][to];
+
+            if ((series->count == 0) && (series->timeouts == 0)) {
+                continue;
+            }
+            printf("%-11s -> %-11s %7zu", stateNames[from], stateNames[to], series->count);
+            LatencyStats_Print(series->values, series->count);
+            printf(" %8lu\n", series->timeouts);
+        }
+    }
+}
+
+int PowerCycleSoak_Run(const PowerCycleSoak_Config_t* config)
+{
+    struct sigaction action;
+    pthread_condattr_t attr;
+    PowerController_PowerState_t current = POWER_STATE_UNKNOWN, previous = POWER_STATE_UNKNOWN;
+    PowerConnect_Stats_t stats;
+    unsigned long cycles = 0, timeouts = 0;
+    uint64_t startNs;
+    uint32_t status;
+    int step = 0;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&changedCond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    /* Stop at the end of the current transition and still print the report */
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    PowerController_Init();
+    status = PowerConnect_WaitCancellable(SOAK_CONNECT_TIMEOUT_MS, &stats, stopCheck, NULL);
+    if (status != POWER_CONTROLLER_ERROR_NONE) {
+        printf("%s\n", (status == POWER_CONNECT_CANCELLED) ? "Stopped while waiting for PowerManager"
+                                                         : "PowerManager plugin unavailable");
+        PowerController_Term();
+        return -1;
+    }
+    printf("PowerController operational after %llu ms (%u connect attempts, %u notifications)\n",
+           (unsigned long long)(stats.elapsedUs / 1000), stats.attempts, stats.notifications);
+    PowerController_RegisterPowerModeChangedCallback(onChanged, NULL);
+
+    /* Walk to the first state unmeasured, the cycle starts there */
+    if ((PowerController_GetPowerState(&current, &previous) == POWER_CONTROLLER_ERROR_NONE) &&
+        (current != config->steps[0].state) && (runTransition(config->steps[0].state, config->timeoutMs) == 0)) {
+        printf("Not able to reach %s, giving up\n", stateName(config->steps[0].state));
+        PowerController_UnRegisterPowerModeChangedCallback(onChanged);
+        PowerController_Term();
+        return -1;
+    }
+    current = config->steps[0].state;
+    dwell(config->steps[0].dwellMs);
+
+    printf("Cycling");
+    for (int i = 0; i < config->stepCount; i++) {
+        printf(" %s", stateName(config->steps[i].state));
+    }
+    printf(" %s", stateName(config->steps[0].state));
+    if (config->cycles > 0) {
+        printf(" %d times\n", config->cycles);
+    } else {
+        printf(" until interrupted\n");
+    }
+
+    startNs = now_ns();
+    while (!stopRequested && ((config->cycles == 0) || (cycles < (unsigned long)config->cycles))) {
+        const PowerCycleSoak_Step_t* next = &config->steps[(step + 1) % config->stepCount];
+        uint64_t latency = runTransition(next->state, config->timeoutMs);
+
+        if (stopRequested && (latency == 0)) {
+            break;
+        }
+        if ((current >= 0) && (current < SOAK_MAX_STATES) && (next->state < SOAK_MAX_STATES)) {
+            if (latency == 0) {
+                transitions[current][next->state].timeouts++;
+            } else {
+                addValue(&transitions[current][next->state], latency);
+            }
+        }
+        if (latency == 0) {
+            timeouts++;
+            printf("Timed out waiting for %s -> %s\n", stateName(current), stateName(next->state));
+            PowerController_GetPowerState(&current, &previous);
+        } else {
+            current = next->state;
+        }
+
+        step = (step + 1) % config->stepCount;
+        if (step == 0) {
+            cycles++;
+        }
+        dwell(next->dwellMs);
+    }
+    printReport(cycles, now_ns() - startNs);
+
+    PowerController_UnRegisterPowerModeChangedCallback(onChanged);
+    PowerController_Term();
+
+    for (int from = 0; from < SOAK_MAX_STATES; from++) {
+        for (int to = 0; to < SOAK_MAX_STATES; to++) {
+            free(transitions[from][to].values);
+        }
+    }
+    return (timeouts == 0) ? 0 : -1;
+}
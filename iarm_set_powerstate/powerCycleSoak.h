@@ -0,0 +1,57 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Power cycle soak mode of SetPowerState: walks a state sequence over one
+ * PowerController connection, waiting for each PowerModeChanged, and
+ * reports cycles per hour and per transition latency percentiles.
+ */
+#ifndef _POWER_CYCLE_SOAK_H_
+#define _POWER_CYCLE_SOAK_H_
+
+#include "power_controller.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SOAK_MAX_STEPS 10
+
+typedef struct _PowerCycleSoak_Step_t {
+    PowerController_PowerState_t state;
+    int dwellMs;            /*!< Time spent in the state once reached */
+} PowerCycleSoak_Step_t;
+
+typedef struct _PowerCycleSoak_Config_t {
+    PowerCycleSoak_Step_t steps[SOAK_MAX_STEPS];
+    int stepCount;
+    int cycles;             /*!< 0: until SIGINT or SIGTERM */
+    int timeoutMs;          /*!< Longest wait for PowerModeChanged */
+} PowerCycleSoak_Config_t;
+
+/* Parse "ON,STANDBY:500,LIGHTSLEEP:2000" into config->steps. Returns 0 on success */
+int PowerCycleSoak_ParseSteps(const char* arg, PowerCycleSoak_Config_t* config);
+
+/* Connects, cycles and prints the report. Returns 0 if no transition timed out */
+int PowerCycleSoak_Run(const PowerCycleSoak_Config_t* config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_CYCLE_SOAK_H_ */
@@ -0,0 +1,297 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ackScheduler.h"
+#include "latencyStats.h"
+#include "preChangeStress.h"
+#include "powerConnect.h"
+
+#define STRESS_CONNECT_TIMEOUT_MS 10000
+
+typedef struct {
+    uint32_t clientId;
+    const PreChangeStress_Profile_t* profile;
+} Client;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t doneCond;     /* Runner: state changed */
+
+static Client clients[STRESS_MAX_CLIENTS];
+static int clientCount = 0;
+static unsigned int seed = 1;
+static unsigned long acksDropped = 0;
+
+static PowerController_PowerState_t awaitedState = POWER_STATE_UNKNOWN;
+static uint64_t changedNs = 0;
+
+static const char* stateNames[] = { "UNKNOWN", "OFF", "STANDBY", "ON", "LIGHT_SLEEP", "DEEP_SLEEP" };
+
+static const char* stateName(PowerController_PowerState_t state)
+{
+    return ((state >= 0) && (state < (int)(sizeof(stateNames) / sizeof(stateNames[0])))) ? stateNames[state] : "?";
+}
+
+static struct timespec to_timespec(uint64_t ns)
+{
+    struct timespec ts = { (time_t)(ns / 1000000000ULL), (long)(ns % 1000000000ULL) };
+    return ts;
+}
+
+/* Every client acks on the scheduler thread at its profile's time from the event */
+static void onPreChange(const PowerController_PowerState_t currentState, const PowerController_PowerState_t newState,
+                        const int transactionId, const int stateChangeAfter, void* userdata)
+{
+    uint64_t receivedNs = AckScheduler_Now();
+
+    pthread_mutex_lock(&lock);
+    for (int i = 0; i < clientCount; i++) {
+        const PreChangeStress_Profile_t* profile = clients[i].profile;
+        int delayMs = profile->minMs;
+
+        if (profile->mode == STRESS_ACK_NEVER) {
+            continue;
+        }
+        if ((profile->mode == STRESS_ACK_RANDOM) && (profile->maxMs > profile->minMs)) {
+            delayMs += rand_r(&seed) % (profile->maxMs - profile->minMs + 1);
+        }
+        if (AckScheduler_Add(ACK_SCHEDULER_ACK, clients[i].clientId, transactionId, 0,
+                             receivedNs, receivedNs + ((uint64_t)delayMs * 1000000ULL)) != 0) {
+            acksDropped++;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void onChanged(const PowerController_PowerState_t currentState, const PowerController_PowerState_t newState, void* userdata)
+{
+    uint64_t receivedNs = AckScheduler_Now();
+
+    pthread_mutex_lock(&lock);
+    if ((newState == awaitedState) && (changedNs == 0)) {
+        changedNs = receivedNs;
+        pthread_cond_broadcast(&doneCond);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static int setClientCount(int count, const PreChangeStress_Config_t* config)
+{
+    char name[32];
+
+    while (clientCount > count) {
+        PowerController_RemovePowerModePreChangeClient(clients[--clientCount].clientId);
+    }
+    while (clientCount < count) {
+        uint32_t clientId = 0;
+
+        snprintf(name, sizeof(name), "stress-%d", clientCount);
+        if (PowerController_AddPowerModePreChangeClient(name, &clientId) != POWER_CONTROLLER_ERROR_NONE) {
+            printf("Not able to add pre-change client %s\n", name);
+            return -1;
+        }
+        pthread_mutex_lock(&lock);
+        clients[clientCount].clientId = clientId;
+        clients[clientCount].profile = &config->profiles[clientCount % config->profileCount];
+        clientCount++;
+        pthread_mutex_unlock(&lock);
+    }
+    return 0;
+}
+
+/* Returns the SetPowerState -> PowerModeChanged latency in ns, 0 on timeout */
+static uint64_t runTransition(PowerController_PowerState_t state, int timeoutMs)
+{
+    uint64_t startNs, latencyNs = 0;
+    struct timespec deadline;
+    uint32_t status;
+
+    pthread_mutex_lock(&lock);
+    awaitedState = state;
+    changedNs = 0;
+    pthread_mutex_unlock(&lock);
+
+    startNs = AckScheduler_Now();
+    status = PowerController_SetPowerState(0, state, "sys_mon_tool[SetPowerState stress]");
+    if (status != POWER_CONTROLLER_ERROR_NONE) {
+        printf("SetPowerState %s failed (%u)\n", stateName(state), status);
+        return 0;
+    }
+
+    deadline = to_timespec(startNs + ((uint64_t)timeoutMs * 1000000ULL));
+    pthread_mutex_lock(&lock);
+    while ((changedNs == 0) && (pthread_cond_timedwait(&doneCond, &lock, &deadline) != ETIMEDOUT)) {
+    }
+    if (changedNs != 0) {
+        latencyNs = changedNs - startNs;
+    }
+    awaitedState = POWER_STATE_UNKNOWN;
+    pthread_mutex_unlock(&lock);
+
+    /* Let late acks drain so they do not run into the next transaction */
+    if (AckScheduler_WaitIdle((uint32_t)timeoutMs) != 0) {
+        printf("Acks for %s still pending after %d ms\n", stateName(state), timeoutMs);
+    }
+    return latencyNs;
+}
+
+static void printLatency(int clients, PowerController_PowerState_t state, uint64_t* values, int count, int timeouts)
+{
+    printf("%7d  %-11s %5d", clients, stateName(state), count);
+    LatencyStats_Print(values, (size_t)count);
+    printf(" %8d\n", timeouts);
+}
+
+int PreChangeStress_ParseProfiles(const char* arg, PreChangeStress_Config_t* config)
+{
+    char buffer[256];
+    char* save = NULL;
+    char* token;
+
+    strncpy(buffer, arg, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    config->profileCount = 0;
+
+    for (token = strtok_r(buffer, ",", &save); token != NULL; token = strtok_r(NULL, ",", &save)) {
+        PreChangeStress_Profile_t* profile = &config->profiles[config->profileCount];
+
+        if (config->profileCount == STRESS_MAX_PROFILES) {
+            return -1;
+        }
+        if (strcmp(token, "never") == 0) {
+            profile->mode = STRESS_ACK_NEVER;
+            profile->minMs = profile->maxMs = 0;
+        } else if (sscanf(token, "fixed:%d", &profile->minMs) == 1) {
+            profile->mode = STRESS_ACK_FIXED;
+            profile->maxMs = profile->minMs;
+        } else if (sscanf(token, "random:%d-%d", &profile->minMs, &profile->maxMs) == 2) {
+            profile->mode = STRESS_ACK_RANDOM;
+        } else {
+            return -1;
+        }
+        if ((profile->minMs < 0) || (profile->maxMs < profile->minMs)) {
+            return -1;
+        }
+        config->profileCount++;
+    }
+    return (config->profileCount > 0) ? 0 : -1;
+}
+
+int PreChangeStress_Run(const PreChangeStress_Config_t* config)
+{
+    pthread_condattr_t attr;
+    PowerController_PowerState_t back = POWER_STATE_UNKNOWN, previous = POWER_STATE_UNKNOWN;
+    int totalTimeouts = 0;
+    uint64_t* toTarget = NULL;
+    uint64_t* toBack = NULL;
+
+    toTarget = (uint64_t*)calloc((size_t)config->iterations, sizeof(uint64_t));
+    toBack = (uint64_t*)calloc((size_t)config->iterations, sizeof(uint64_t));
+    if ((toTarget == NULL) || (toBack == NULL)) {
+        printf("Not able to allocate %d latency samples\n", config->iterations);
+        free(toTarget);
+        free(toBack);
+        return -1;
+    }
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&doneCond, &attr);
+    pthread_condattr_destroy(&attr);
+    seed = (unsigned int)AckScheduler_Now();
+    acksDropped = 0;
+
+    if (AckScheduler_Start(false) != 0) {
+        free(toTarget);
+        free(toBack);
+        return -1;
+    }
+
+    PowerController_Init();
+    if (PowerConnect_Wait(STRESS_CONNECT_TIMEOUT_MS, NULL) != POWER_CONTROLLER_ERROR_NONE) {
+        printf("PowerManager plugin unavailable\n");
+        AckScheduler_Stop();
+        PowerController_Term();
+        free(toTarget);
+        free(toBack);
+        return -1;
+    }
+    if ((PowerController_GetPowerState(&back, &previous) != POWER_CONTROLLER_ERROR_NONE) || (back == config->target)) {
+        printf("Box must start in a state other than %s\n", stateName(config->target));
+        AckScheduler_Stop();
+        PowerController_Term();
+        free(toTarget);
+        free(toBack);
+        return -1;
+    }
+
+    PowerController_RegisterPowerModePreChangeCallback(onPreChange, NULL);
+    PowerController_RegisterPowerModeChangedCallback(onChanged, NULL);
+
+    printf("%d round trips %s -> %s -> %s per client count, latency in ms\n\n",
+           config->iterations, stateName(back), stateName(config->target), stateName(back));
+    printf("%7s  %-11s %5s %9s %9s %9s %9s %9s %8s\n", "clients", "to", "count", "min", "p50", "p90", "p99", "max", "timeouts");
+
+    for (int c = 0; c < config->clientCountSize; c++) {
+        int targetCount = 0, backCount = 0, targetTimeouts = 0, backTimeouts = 0;
+
+        if (setClientCount(config->clientCounts[c], config) != 0) {
+            break;
+        }
+        for (int i = 0; i < config->iterations; i++) {
+            uint64_t latency = runTransition(config->target, config->timeoutMs);
+
+            if (latency == 0) {
+                targetTimeouts++;
+            } else {
+                toTarget[targetCount++] = latency;
+            }
+            latency = runTransition(back, config->timeoutMs);
+            if (latency == 0) {
+                backTimeouts++;
+            } else {
+                toBack[backCount++] = latency;
+            }
+        }
+        printLatency(config->clientCounts[c], config->target, toTarget, targetCount, targetTimeouts);
+        printLatency(config->clientCounts[c], back, toBack, backCount, backTimeouts);
+        totalTimeouts += targetTimeouts + backTimeouts;
+    }
+    printf("\n");
+
+    setClientCount(0, config);
+    PowerController_UnRegisterPowerModeChangedCallback(onChanged);
+    PowerController_UnRegisterPowerModePreChangeCallback(onPreChange);
+    AckScheduler_Stop();
+    if (acksDropped > 0) {
+        printf("%lu acknowledgements dropped, more than %d pending\n", acksDropped, ACK_SCHEDULER_MAX_ACTIONS);
+    }
+    PowerController_Term();
+
+    free(toTarget);
+    free(toBack);
+    return (totalTimeouts == 0) ? 0 : -1;
+}
@@ -0,0 +1,72 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Pre-change arbitration stress harness of SetPowerState.
+ *
+ * Registers N pre-change clients from one process, acknowledges each
+ * transaction per client profile through the ack scheduler, and measures
+ * the time from PowerController_SetPowerState until PowerModeChanged for
+ * every client count.
+ */
+#ifndef _PRE_CHANGE_STRESS_H_
+#define _PRE_CHANGE_STRESS_H_
+
+#include "power_controller.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STRESS_MAX_COUNTS 10
+#define STRESS_MAX_PROFILES 10
+#define STRESS_MAX_CLIENTS 256
+
+typedef enum _PreChangeStress_AckMode_t {
+    STRESS_ACK_FIXED,       /*!< Acknowledge after minMs */
+    STRESS_ACK_RANDOM,      /*!< Acknowledge after minMs..maxMs */
+    STRESS_ACK_NEVER,       /*!< Let PowerManager time the client out */
+} PreChangeStress_AckMode_t;
+
+typedef struct _PreChangeStress_Profile_t {
+    PreChangeStress_AckMode_t mode;
+    int minMs;
+    int maxMs;
+} PreChangeStress_Profile_t;
+
+typedef struct _PreChangeStress_Config_t {
+    PowerController_PowerState_t target;
+    int clientCounts[STRESS_MAX_COUNTS];
+    int clientCountSize;
+    PreChangeStress_Profile_t profiles[STRESS_MAX_PROFILES];   /*!< Assigned to clients round robin */
+    int profileCount;
+    int iterations;         /*!< Round trips per client count */
+    int timeoutMs;          /*!< Longest wait for PowerModeChanged */
+} PreChangeStress_Config_t;
+
+/* Parse "fixed:MS,random:MIN-MAX,never" into config->profiles. Returns 0 on success */
+int PreChangeStress_ParseProfiles(const char* arg, PreChangeStress_Config_t* config);
+
+/* Connects, runs every client count and prints the report. Returns 0 if no transition timed out */
+int PreChangeStress_Run(const PreChangeStress_Config_t* config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PRE_CHANGE_STRESS_H_ */
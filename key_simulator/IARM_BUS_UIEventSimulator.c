@@ -16,21 +16,33 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
 */
+#include <ctype.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <stdbool.h>
+#include <time.h>
+#include <linux/input.h>
 #include "libIBus.h"
 #include "UIEventSimulator.h"
 #include "libIARM.h"
 #include "uInputInternal.h"
+#include "keyTiming.h"
+#include "keyRecord.h"
 
 //#define TRACE
 
 IARM_Result_t UIEventSimulator_Start();
 IARM_Result_t findKeyCode(char command[]);
 IARM_Result_t sendCommand();
+IARM_Result_t sendText(const char *text);
+IARM_Result_t parseLongOption(int *argc, char **argv[]);
+static bool recordsToStdout(int argc, char *argv[]);
+static int parseTimingOverride(const char *name, const char *value, KeyTiming_Config_t *timing);
+static void sleepUs(uint64_t us);
+static int findTextKeyCode(char c);
 void sendKeyEventToIARM(int keyType, int keyCode);
 void usage(void);
 
@@ -42,19 +54,45 @@ static int interval = 1;
 static int repeat = 1;
 static int pressAndHold = 0;
 static int duration = 5;
+static uint64_t seed = 0;
+static bool seedSet = false;
+static const char *typeText = NULL;
+static int typeDelayMs = 20;
+static int settleMs = 1000;
+static const char *recordNode = NULL;
+static const char *replayFile = NULL;
+static const char *recordFile = NULL;
+static double replaySpeed = 1.0;
+
+/* --autorepeat, --hold, --gap and --burst, applied on top of the --profile defaults */
+#define MAX_TIMING_OVERRIDES 8
+static struct {
+	const char *name;
+	const char *value;
+} timingOverrides[MAX_TIMING_OVERRIDES];
+static int timingOverrideCount = 0;
 
 /**
  * @brief main!
  */
 int main(int argc, char *argv[])
 {
+	int recordFd = -1;
+
 #ifdef TRACE
 	printf("[FUNC] %s [LINE] %d\n", __FUNCTION__, __LINE__);
 #endif
 
-	if (UIEventSimulator_Start() != IARM_RESULT_SUCCESS)
+	KeySimLog_Init();
+	if (recordsToStdout(argc, argv))
 	{
-		return 0;
+		/* Keep stdout for the recording alone, everything else goes to stderr */
+		recordFd = dup(STDOUT_FILENO);
+		if ((recordFd < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+		{
+			perror("Not able to set up stdout for recording");
+			return 0;
+		}
 	}
 
 	printf("\n\nProgram name: %s\n", argv[0]);
@@ -97,6 +135,14 @@ int main(int argc, char *argv[])
 			duration = atoi(&argv[1][2]);
 			pressAndHold = 1;
 			break;
+
+		case '-':
+			if (parseLongOption(&argc, &argv) != IARM_RESULT_SUCCESS)
+			{
+				printf("Wrong Arguments %s Exit %s\n", argv[1], executableName);
+				return 0;
+			}
+			break;
 		default:
 			printf("Wrong Arguments %s\n", argv[1]);
 			break;
@@ -106,23 +152,96 @@ int main(int argc, char *argv[])
 		--argc;
 	}
 
-	if (keyCode >= 0)
+	/* A profile only sets defaults, whatever the order on the command line */
+	for (int i = 0; i < timingOverrideCount; i++)
+	{
+		parseTimingOverride(timingOverrides[i].name, timingOverrides[i].value, KeyTiming_GetConfig());
+	}
+
+	if (!seedSet)
 	{
+		seed = (uint64_t)time(NULL);
+	}
+	KeyTiming_Seed(seed);
+
+	if (recordNode != NULL)
+	{
+		/* Only reads evdev, no uinput device or IARM connection needed */
+		FILE *out = (recordFile != NULL) ? fopen(recordFile, "w") : fdopen(recordFd, "w");
+		if (out == NULL)
+		{
+			printf("Not able to create %s\n", (recordFile != NULL) ? recordFile : "stdout");
+			return 0;
+		}
+		KeyRecord_Record(recordNode, out);
+		fclose(out);
+		return 0;
+	}
+	if ((keyCode >= 0) || (typeText != NULL) || (replayFile != NULL))
+	{
+		if (UIEventSimulator_Start() != IARM_RESULT_SUCCESS)
+		{
+			return 0;
+		}
+		printf("Timing profile seed = %llu\n", (unsigned long long)seed);
 		/* Allow extra time for other apps(for example, asserviced)
 		 * to listen to the event. There is no handshake between
 		 * keySimulator and other apps. Thus there is no way the other
 		 * app notifies keySimulator that the file descriptor of
 		 * /dev/input/eventx is added into the event loop by the other
 		 * app. Therefore, after UI_DEV_CREATE and before sending first
-		 * key, extra one second reasonable delay is given.
+		 * key, extra one second reasonable delay is given (--settle).
 		 */
-		sleep(1);
-		sendCommand();
+		sleepUs((uint64_t)settleMs * 1000);
+		if (replayFile != NULL)
+		{
+			/* -r replays the recording that many times */
+			for (int i = 0; i < repeat; i++)
+			{
+				int replayed = KeyRecord_Replay(replayFile, replaySpeed, sendKeyEventToIARM);
+				if (replayed < 0)
+				{
+					printf("Replay of %s failed\n", replayFile);
+					break;
+				}
+				printf("Replayed %d key events\n", replayed);
+			}
+		}
+		else if (typeText != NULL)
+		{
+			sendText(typeText);
+		}
+		else
+		{
+			sendCommand();
+		}
+		UIEventSimulator_Stop();
 	}
-	UIEventSimulator_Stop();
 	return 0;
 }
 
+/**
+ * @brief true if the command line records to stdout (--record without --file).
+ */
+static bool recordsToStdout(int argc, char *argv[])
+{
+	bool record = false;
+	bool file = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strncmp(argv[i], "--record", 8) == 0)
+		{
+			record = true;
+		}
+		else if (strncmp(argv[i], "--file", 6) == 0)
+		{
+			file = true;
+		}
+	}
+	return record && !file;
+}
+
 /**
  * @brief Initialize the IARM.
  *
@@ -139,6 +258,177 @@ IARM_Result_t UIEventSimulator_Start()
 	return IARM_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Returns the value of a "--name=value" or "--name value" option, NULL if argv[1] is not that option.
+ */
+static const char* longOptionValue(const char *name, int *argc, char **argv[])
+{
+	const char *arg = (*argv)[1] + 2;
+	size_t len = strlen(name);
+
+	if (strncmp(arg, name, len) != 0)
+	{
+		return NULL;
+	}
+	if (arg[len] == '=')
+	{
+		return &arg[len + 1];
+	}
+	if ((arg[len] == '\0') && (*argc > 2))
+	{
+		/* Value is the next argument; consume it */
+		++(*argv);
+		--(*argc);
+		return (*argv)[1];
+	}
+	return NULL;
+}
+
+/**
+ * @brief Handle the long (--) options.
+ *
+ * @return IARM_Result_t Error Code.
+ */
+IARM_Result_t parseLongOption(int *argc, char **argv[])
+{
+	static const char *timingOptions[] = { "autorepeat", "hold", "gap", "burst" };
+	const char *value = NULL;
+
+	for (size_t i = 0; i < (sizeof(timingOptions) / sizeof(timingOptions[0])); i++)
+	{
+		if ((value = longOptionValue(timingOptions[i], argc, argv)) != NULL)
+		{
+			KeyTiming_Config_t scratch;
+
+			/* Checked now, applied once the profile is known */
+			if ((timingOverrideCount == MAX_TIMING_OVERRIDES) ||
+			    (parseTimingOverride(timingOptions[i], value, &scratch) != 0))
+			{
+				return IARM_RESULT_INVALID_PARAM;
+			}
+			timingOverrides[timingOverrideCount].name = timingOptions[i];
+			timingOverrides[timingOverrideCount].value = value;
+			timingOverrideCount++;
+			return IARM_RESULT_SUCCESS;
+		}
+	}
+
+	if ((value = longOptionValue("profile", argc, argv)) != NULL)
+	{
+		printf("Timing profile = %s\n", value);
+		if (KeyTiming_SetProfile(value) != 0)
+		{
+			return IARM_RESULT_INVALID_PARAM;
+		}
+	}
+	else if ((value = longOptionValue("type-delay", argc, argv)) != NULL)
+	{
+		typeDelayMs = atoi(value);
+	}
+	else if ((value = longOptionValue("type", argc, argv)) != NULL)
+	{
+		printf("Text = %s\n", value);
+		/* Refuse the whole text rather than type part of it */
+		for (const char *c = value; *c != '\0'; c++)
+		{
+			if (findTextKeyCode(*c) < 0)
+			{
+				printf("No key for character '%c' (0x%02x)\n", isprint((unsigned char)*c) ? *c : '?', (unsigned char)*c);
+				return IARM_RESULT_INVALID_PARAM;
+			}
+		}
+		typeText = value;
+	}
+	else if ((value = longOptionValue("settle", argc, argv)) != NULL)
+	{
+		settleMs = atoi(value);
+	}
+	else if ((value = longOptionValue("record", argc, argv)) != NULL)
+	{
+		recordNode = value;
+	}
+	else if ((value = longOptionValue("replay", argc, argv)) != NULL)
+	{
+		replayFile = value;
+	}
+	else if ((value = longOptionValue("file", argc, argv)) != NULL)
+	{
+		recordFile = value;
+	}
+	else if ((value = longOptionValue("speed", argc, argv)) != NULL)
+	{
+		/* "max" replays without any waits */
+		replaySpeed = (strcmp(value, "max") == 0) ? 0.0 : atof(value);
+		if (replaySpeed < 0.0)
+		{
+			return IARM_RESULT_INVALID_PARAM;
+		}
+	}
+	else if ((value = longOptionValue("log-level", argc, argv)) != NULL)
+	{
+		keySimLogLevel = atoi(value);
+	}
+	else if (strcmp((*argv)[1], "--log-ring") == 0)
+	{
+		KeySimLog_SetRing(true);
+	}
+	else if ((value = longOptionValue("seed", argc, argv)) != NULL)
+	{
+		seed = strtoull(value, NULL, 0);
+		seedSet = true;
+	}
+	else
+	{
+		return IARM_RESULT_INVALID_PARAM;
+	}
+
+	return IARM_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Apply one of the timing options (autorepeat, hold, gap, burst) to timing.
+ *
+ * @return 0 on success, -1 if value is malformed.
+ */
+static int parseTimingOverride(const char *name, const char *value, KeyTiming_Config_t *timing)
+{
+	if (strcmp(name, "autorepeat") == 0)
+	{
+		return (sscanf(value, "%u,%u", &timing->repeatDelayMs, &timing->repeatPeriodMs) == 2) ? 0 : -1;
+	}
+	if (strcmp(name, "hold") == 0)
+	{
+		return (sscanf(value, "%u,%u", &timing->holdMeanMs, &timing->holdJitterMs) >= 1) ? 0 : -1;
+	}
+	if (strcmp(name, "gap") == 0)
+	{
+		return (sscanf(value, "%u,%u", &timing->gapMeanMs, &timing->gapJitterMs) >= 1) ? 0 : -1;
+	}
+	if (strcmp(name, "burst") == 0)
+	{
+		if (sscanf(value, "%u,%u,%u", &timing->burstMin, &timing->burstMax, &timing->burstPauseMs) != 3)
+		{
+			return -1;
+		}
+		return ((timing->burstMin >= 1) && (timing->burstMax >= timing->burstMin)) ? 0 : -1;
+	}
+	return -1;
+}
+
+/**
+ * @brief Sleep for us microseconds; usleep() cannot take the longer --gap and -i waits.
+ */
+static void sleepUs(uint64_t us)
+{
+	struct timespec ts;
+
+	ts.tv_sec = (time_t)(us / 1000000ULL);
+	ts.tv_nsec = (long)((us % 1000000ULL) * 1000ULL);
+	while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR))
+	{
+	}
+}
+
 /**
  * @brief Given a string find the key code (KED_*)
  *
@@ -178,7 +468,8 @@ IARM_Result_t findKeyCode(char command[])
 
 IARM_Result_t sendCommand()
 {
-	int i,j;
+	int i;
+	uint32_t j, repeats;
 
 #ifdef TRACE
 	printf("[FUNC] %s [LINE] %d\n", __FUNCTION__, __LINE__);
@@ -188,29 +479,99 @@ IARM_Result_t sendCommand()
 /* Allow a fraction of second for EPG to get ready to receive key events
  * from the newly created input dev via UINPUT_init()
 */
-	usleep(50000);
+	sleepUs(50000);
 	for (i = 0; i < repeat; i++)
 	{
 		if (pressAndHold)
 		{
+			/* Autorepeat: first repeat after the delay, then one per period */
+			repeats = KeyTiming_RepeatCount(duration * 1000);
 			sendKeyEventToIARM(KET_KEYDOWN, keyCode);
-			usleep(50000);
-			for (j = 0;j < duration*20  ;j++ )
+			sleepUs(KeyTiming_RepeatDelayUs());
+			for (j = 0; j < repeats; j++)
 			{
 				sendKeyEventToIARM(KET_KEYREPEAT, keyCode);
-				usleep(50000);
+				sleepUs(KeyTiming_RepeatPeriodUs());
 			}
 			sendKeyEventToIARM(KET_KEYUP, keyCode);
-				usleep(50000);
-			sleep(interval);
+				sleepUs(50000);
 		}
 		else
 		{
 		sendKeyEventToIARM(KET_KEYDOWN, keyCode);
-		usleep(100);
+		sleepUs(KeyTiming_TapHoldUs());
 		sendKeyEventToIARM(KET_KEYUP, keyCode);
-		sleep(interval);
 		}
+		sleepUs(KeyTiming_NextGapUs(interval));
+	}
+
+	return IARM_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Map a character to the key code (KED_*) that produces it on the uinput device.
+ *
+ * Digits and A-D have dedicated remote keys; other letters are only reachable
+ * where kcodesMap_IARM2Linux has a CTRL+letter combination for them. Anything
+ * else is refused: the keys that produce '*', '+', '-' or Enter on the device
+ * are the remote's MUTE, VOLUMEUP, VOLUMEDOWN and SELECT, not text.
+ *
+ * @return the key code, -1 if the character cannot be typed.
+ */
+static int findTextKeyCode(char c)
+{
+	static const char qwerty[3][11] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+	static const int qwertyFirst[3] = { KEY_Q, KEY_A, KEY_Z };
+	uint32_t iCode = KED_UNDEFINEDKEY;
+	const char *pos;
+	int row;
+
+	if ((c >= '0') && (c <= '9'))
+	{
+		iCode = UINPUT_GetIARMKeyCode((c == '0') ? KEY_0 : (uint32_t)(KEY_1 + (c - '1')), KEY_RESERVED);
+	}
+	else if (((c >= 'a') && (c <= 'd')) || ((c >= 'A') && (c <= 'D')))
+	{
+		static const int keys[] = { KED_KEYA, KED_KEYB, KED_KEYC, KED_KEYD };
+		return keys[(c | 0x20) - 'a'];
+	}
+	else if (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')))
+	{
+		for (row = 0; row < 3; row++)
+		{
+			if ((pos = strchr(qwerty[row], c | 0x20)) != NULL)
+			{
+				iCode = UINPUT_GetIARMKeyCode(qwertyFirst[row] + (pos - qwerty[row]), KEY_LEFTCTRL);
+				break;
+			}
+		}
+	}
+
+	return (iCode == KED_UNDEFINEDKEY) ? -1 : (int)iCode;
+}
+
+/**
+ * @brief Type a whole string through the one uinput device, --type-delay apart.
+ *
+ * @return IARM_Result_t Error Code.
+ */
+IARM_Result_t sendText(const char *text)
+{
+	int code;
+
+	sleepUs(50000);
+	for (; *text != '\0'; text++)
+	{
+		code = findTextKeyCode(*text);
+		if (code < 0)
+		{
+			printf("No key for character '%c'\n", *text);
+			return IARM_RESULT_INVALID_PARAM;
+		}
+		sendKeyEventToIARM(KET_KEYDOWN, code);
+		sleepUs(KeyTiming_TapHoldUs());
+		sendKeyEventToIARM(KET_KEYUP, code);
+		sleepUs((uint64_t)typeDelayMs * 1000);
 	}
 
 	return IARM_RESULT_SUCCESS;
@@ -227,15 +588,15 @@ void sendKeyEventToIARM(int keyType, int keyCode)
 	printf("[FUNC] %s [LINE] %d\n", __FUNCTION__, __LINE__);
 #endif
 
-	printf("Sending Key (%x, %x) from %s\r\n", keyType, keyCode, executableName);
-        printf("%d:%s: Using UINPUT dispatcher", __LINE__, __func__);
+	LOG(KEYSIM_LOG_DEBUG, "Sending Key (%x, %x) from %s\r\n", keyType, keyCode, executableName);
+        LOG(KEYSIM_LOG_DEBUG, "%d:%s: Using UINPUT dispatcher\n", __LINE__, __func__);
         uinput_dispatcher_t dispatcher = UINPUT_GetDispatcher();
         // Copilot fix: Added null pointer check to prevent crash when dispatcher is unavailable
         if (dispatcher != NULL) {
             /*Time being replacing scan code with 0 to run the functionality*/
             dispatcher( keyCode, keyType, 0);
         } else {
-            printf("%d:%s: Error: UINPUT dispatcher not available\n", __LINE__, __func__ );
+            LOG(KEYSIM_LOG_ERROR, "%d:%s: Error: UINPUT dispatcher not available\n", __LINE__, __func__ );
         }
 }
 
@@ -262,6 +623,24 @@ void usage(void)
 	printf("-p press and hold for interval (default is 5 seconds)\n");
 	printf("-i interval between commands (default 1 second\n");
 	printf("-k command to send (see list below)\n");
+	printf("--type <TEXT> type TEXT (digits, A-D and letters with a CTRL combination) in one run\n");
+	printf("--type-delay=<MS> delay between typed characters (default 20ms)\n");
+	printf("--settle=<MS> wait after creating the input device before the first key (default 1000ms)\n");
+	printf("--record <NODE> record key events from an evdev node (/dev/input/eventX) until Ctrl-C\n");
+	printf("--file <FILE> recording to write (default stdout, messages then go to stderr)\n");
+	printf("--replay <FILE> replay a recording, -r times\n");
+	printf("--speed=<N|max> replay N times faster, max for no waits (default 1)\n");
+	printf("--log-level=<0-3> 0 none, 1 errors, 2 info (default), 3 every key event (KEYSIM_LOG_LEVEL)\n");
+	printf("--log-ring keep log messages in memory and print them on exit (KEYSIM_LOG_RING=1)\n");
+	printf("--profile=<fixed|human|surf> key timing profile (default fixed)\n");
+	printf("\t fixed: 100us taps, repeats every 50ms, -i seconds between keys\n");
+	printf("\t human: jittered taps and gaps, kernel style autorepeat (250ms delay, 33ms period)\n");
+	printf("\t surf : bursts of quick presses separated by long pauses\n");
+	printf("--seed=<N> seed for the timing profile, to reproduce a run (printed on every run)\n");
+	printf("--autorepeat=<DELAY_MS>,<PERIOD_MS> press and hold repeat delay and period\n");
+	printf("--hold=<MEAN_MS>[,<JITTER_MS>] tap hold time (human, surf)\n");
+	printf("--gap=<MEAN_MS>[,<JITTER_MS>] time between keys (human, surf)\n");
+	printf("--burst=<MIN>,<MAX>,<PAUSE_MS> presses per burst and pause between bursts (surf)\n");
 	for (index = 0; index < length; index++)
 	{
 		printf("KeyCode = %s \n", table[index].comamnd);
@@ -272,6 +651,10 @@ void usage(void)
 	printf("\t %s -kexit -p3\n", executableName);
 	printf("\t %s -r10 -i10 -kchup\n", executableName);
 	printf("\t %s -kchdown -r5 \n", executableName);
+	printf("\t %s -kchup -r40 --profile=surf --seed=42\n", executableName);
+	printf("\t %s --type \"2024\" --type-delay=10\n", executableName);
+	printf("\t %s --record /dev/input/event1 --file /tmp/session.keys\n", executableName);
+	printf("\t %s --replay /tmp/session.keys --speed=10 -r5\n", executableName);
 	printf("-                                                -\n");
 	printf("--                                              --\n");
 	printf("---                                            ---\n");
@@ -0,0 +1,170 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uInputInternal.h"
+#include "keyRecord.h"
+#include "comcastIrKeyCodes.h"
+
+static volatile sig_atomic_t stopRecording = 0;
+
+static void onStopSignal(int sig)
+{
+    (void)sig;
+    stopRecording = 1;
+}
+
+static uint64_t eventTimeUs(const struct input_event *ev)
+{
+#ifdef input_event_sec
+    return ((uint64_t)ev->input_event_sec * 1000000ULL) + (uint64_t)ev->input_event_usec;
+#else
+    return ((uint64_t)ev->time.tv_sec * 1000000ULL) + (uint64_t)ev->time.tv_usec;
+#endif
+}
+
+int KeyRecord_Record(const char *devNode, FILE *out)
+{
+    struct sigaction sa;
+    struct input_event events[64];
+    struct pollfd pfd;
+    uint64_t firstUs = 0;
+    int ctrlDown = 0;
+    int recorded = 0;
+    int fd = -1;
+
+    fd = open(devNode, O_RDONLY | O_NONBLOCK);
+    if (fd < 0) {
+        LOG(KEYSIM_LOG_ERROR, "Not able to open %s: %s\n", devNode, strerror(errno));
+        return -1;
+    }
+
+    /* No SA_RESTART: a signal has to interrupt the poll */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onStopSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    fprintf(out, "# keySimulator record v1 from %s\n", devNode);
+    fprintf(out, "# <usec> <KET type> <KED code>\n");
+    LOG(KEYSIM_LOG_INFO, "Recording %s, stop with Ctrl-C\n", devNode);
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    while (!stopRecording) {
+        if (poll(&pfd, 1, 500) <= 0) {
+            continue;
+        }
+        ssize_t len = read(fd, events, sizeof(events));
+        if (len <= 0) {
+            if ((len < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+                LOG(KEYSIM_LOG_ERROR, "Read from %s failed: %s\n", devNode, strerror(errno));
+                break;
+            }
+            continue;
+        }
+        for (size_t i = 0; i < (size_t)len / sizeof(events[0]); i++) {
+            const struct input_event *ev = &events[i];
+            uint32_t iCode = KED_UNDEFINEDKEY;
+            int keyType;
+
+            if (ev->type != EV_KEY) {
+                continue;
+            }
+            /* The modifier is folded into the key code, see IARM_TO_LINUX_CTL */
+            if ((ev->code == KEY_LEFTCTRL) || (ev->code == KEY_RIGHTCTRL)) {
+                ctrlDown = (ev->value != 0);
+                continue;
+            }
+            if (ctrlDown) {
+                iCode = UINPUT_GetIARMKeyCode(ev->code, KEY_LEFTCTRL);
+            }
+            if (iCode == KED_UNDEFINEDKEY) {
+                iCode = UINPUT_GetIARMKeyCode(ev->code, KEY_RESERVED);
+            }
+            if (iCode == KED_UNDEFINEDKEY) {
+                LOG(KEYSIM_LOG_DEBUG, "No IARM key for Linux key %d, skipped\n", ev->code);
+                continue;
+            }
+            keyType = (ev->value == 0) ? KET_KEYUP : ((ev->value == 2) ? KET_KEYREPEAT : KET_KEYDOWN);
+            if (recorded == 0) {
+                firstUs = eventTimeUs(ev);
+            }
+            fprintf(out, "%llu %x %x\n", (unsigned long long)(eventTimeUs(ev) - firstUs), keyType, iCode);
+            recorded++;
+        }
+    }
+
+    LOG(KEYSIM_LOG_INFO, "Recorded %d key events\n", recorded);
+    fflush(out);
+    close(fd);
+    return 0;
+}
+
+int KeyRecord_Replay(const char *fileName, double speed, keyRecord_send_t send)
+{
+    struct timespec start;
+    char line[128];
+    int replayed = 0;
+    FILE *in = NULL;
+
+    in = fopen(fileName, "r");
+    if (in == NULL) {
+        LOG(KEYSIM_LOG_ERROR, "Not able to open %s: %s\n", fileName, strerror(errno));
+        return -1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (fgets(line, sizeof(line), in) != NULL) {
+        unsigned long long offsetUs = 0;
+        int keyType = 0;
+        int keyCode = 0;
+
+        if ((line[0] == '#') || (sscanf(line, "%llu %x %x", &offsetUs, &keyType, &keyCode) != 3)) {
+            continue;
+        }
+        if (speed > 0) {
+            /* Absolute deadlines, so dispatch time does not accumulate as drift */
+            uint64_t due = (uint64_t)(offsetUs * 1000.0 / speed);
+            struct timespec deadline = start;
+            deadline.tv_sec += due / 1000000000ULL;
+            deadline.tv_nsec += due % 1000000000ULL;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+            }
+        }
+        send(keyType, keyCode);
+        replayed++;
+    }
+
+    fclose(in);
+    return replayed;
+}
@@ -0,0 +1,72 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file keyRecord.h
+*
+* @brief Record remote input from an evdev node and replay it through keySimulator.
+*
+* Recordings are text, one key event per line:
+*
+*     <microseconds since first event> <KET_* type> <KED_* code>
+*
+* with '#' comment lines, so they can be edited by hand into scripts.
+*
+*/
+
+#ifndef _KEY_RECORD_H_
+#define _KEY_RECORD_H_
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (* keyRecord_send_t) (int keyType, int keyCode);
+
+/**
+ * @brief record key events from an evdev node until SIGINT/SIGTERM.
+ *
+ * Linux key codes (with a held CTRL) are translated back to KED_* codes;
+ * keys without an IARM equivalent are skipped.
+ *
+ * @param [in] devNode the /dev/input/eventX node to read.
+ * @param [in] out stream the recording is written to, left open.
+ *
+ * @return 0 on success, -1 on error.
+ */
+int KeyRecord_Record(const char *devNode, FILE *out);
+
+/**
+ * @brief replay a recording.
+ *
+ * @param [in] fileName recording to read.
+ * @param [in] speed time compression factor (2 plays twice as fast), 0 for no waits at all.
+ * @param [in] send called for every key event.
+ *
+ * @return number of key events replayed, -1 on error.
+ */
+int KeyRecord_Replay(const char *fileName, double speed, keyRecord_send_t send);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KEY_RECORD_H_ */
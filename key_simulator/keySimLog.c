@@ -0,0 +1,149 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Logging for the key injection path.
+ *
+ * Messages go to the console (or the RDK logger) by default. In ring mode
+ * they are only formatted into a fixed in-memory ring; writers claim a slot
+ * with one atomic increment, so injecting threads never block or do I/O.
+ * The ring is dumped to stderr on exit.
+ */
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "uInputInternal.h"
+
+#ifdef RDK_LOGGER_ENABLED
+#include "rdk_debug.h"
+
+extern int b_rdk_logger_enabled;
+#endif
+
+#define RING_SLOTS 512
+#define RING_MSG_SIZE 160
+
+typedef struct {
+    atomic_uint_fast64_t seq;   /* index + 1 once the slot is complete, 0 while being written */
+    uint64_t timeNs;
+    int level;
+    char msg[RING_MSG_SIZE];
+} RingSlot;
+
+int keySimLogLevel = KEYSIM_LOG_INFO;
+
+static bool ringEnabled = false;
+static bool initDone = false;
+static RingSlot ring[RING_SLOTS];
+static atomic_uint_fast64_t ringHead;
+static uint64_t ringTail;
+
+static const char* levelName(int level)
+{
+    switch (level) {
+    case KEYSIM_LOG_ERROR:
+        return "ERROR";
+    case KEYSIM_LOG_INFO:
+        return "INFO";
+    default:
+        return "DEBUG";
+    }
+}
+
+void KeySimLog_Init(void)
+{
+    const char *env = NULL;
+
+    if (initDone) {
+        return;
+    }
+    initDone = true;
+
+    env = getenv("KEYSIM_LOG_LEVEL");
+    if (env != NULL) {
+        keySimLogLevel = atoi(env);
+    }
+    env = getenv("KEYSIM_LOG_RING");
+    if ((env != NULL) && (atoi(env) != 0)) {
+        ringEnabled = true;
+    }
+    atexit(KeySimLog_Dump);
+}
+
+void KeySimLog_SetRing(bool enable)
+{
+    ringEnabled = enable;
+}
+
+void KeySimLog_Write(int level, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    if (ringEnabled) {
+        uint64_t index = atomic_fetch_add_explicit(&ringHead, 1, memory_order_relaxed);
+        RingSlot *slot = &ring[index % RING_SLOTS];
+        struct timespec ts;
+
+        atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        slot->timeNs = ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+        slot->level = level;
+        vsnprintf(slot->msg, sizeof(slot->msg), format, args);
+        atomic_store_explicit(&slot->seq, index + 1, memory_order_release);
+    }
+    else {
+#ifdef RDK_LOGGER_ENABLED
+        if (b_rdk_logger_enabled) {
+            char buffer[RING_MSG_SIZE];
+            vsnprintf(buffer, sizeof(buffer), format, args);
+            RDK_LOG((level == KEYSIM_LOG_ERROR) ? RDK_LOG_ERROR : RDK_LOG_DEBUG, "LOG.RDK.KEYSIMULATOR", "%s", buffer);
+        }
+        else
+#endif
+        {
+            vprintf(format, args);
+        }
+    }
+    va_end(args);
+}
+
+void KeySimLog_Dump(void)
+{
+    uint64_t head = atomic_load_explicit(&ringHead, memory_order_acquire);
+    uint64_t index = ringTail;
+
+    if ((head - index) > RING_SLOTS) {
+        fprintf(stderr, "[keysim log: %llu older messages overwritten]\n",
+                (unsigned long long)(head - index - RING_SLOTS));
+        index = head - RING_SLOTS;
+    }
+    for (; index < head; index++) {
+        RingSlot *slot = &ring[index % RING_SLOTS];
+        /* Skip slots that were overwritten or are still being written */
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != (index + 1)) {
+            continue;
+        }
+        fprintf(stderr, "%llu.%06llu %s %s", (unsigned long long)(slot->timeNs / 1000000000ULL),
+                (unsigned long long)((slot->timeNs % 1000000000ULL) / 1000ULL), levelName(slot->level), slot->msg);
+    }
+    ringTail = head;
+}
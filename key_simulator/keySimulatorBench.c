@@ -0,0 +1,378 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Key injection benchmark.
+ *
+ * Creates the keySimulator uinput device, reads it back through its evdev
+ * node and injects keys through the uinput dispatcher at increasing rates.
+ * Every key is timestamped before injection and on delivery to the reader,
+ * so the whole dispatcher -> /dev/uinput -> /dev/input/eventX path is
+ * measured. The keys cycle through the digits and each delivered event is
+ * matched to its injection by key code and value, so a lost or unexpected
+ * event cannot shift the latencies of the ones after it. Only /dev/uinput
+ * is needed, no STB hardware or IARM bus.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uInputInternal.h"
+#include "comcastIrKeyCodes.h"
+
+#define MAX_RATES 32
+#define DEFAULT_KEYS_PER_STEP 1000
+#define DEFAULT_P99_LIMIT_MS 10
+#define DRAIN_TIMEOUT_MS 1000
+
+static const int defaultRates[] = { 100, 250, 500, 1000, 2000, 5000, 10000, 20000 };
+static const int benchKeys[] = { KED_DIGIT0, KED_DIGIT1, KED_DIGIT2, KED_DIGIT3, KED_DIGIT4,
+                                 KED_DIGIT5, KED_DIGIT6, KED_DIGIT7, KED_DIGIT8, KED_DIGIT9 };
+
+#define BENCH_KEY_COUNT ((int)(sizeof(benchKeys) / sizeof(benchKeys[0])))
+
+typedef struct {
+    int evFd;
+    uint64_t* injectNs;     /* per injected EV_KEY event, written by the injector */
+    uint64_t* deliverNs;    /* per delivered EV_KEY event in arrival order, written by the reader */
+    uint16_t* deliverCode;  /* Linux key code of the delivered event */
+    int32_t* deliverValue;  /* 1 down, 0 up, 2 repeat */
+    int capacity;           /* deliveries kept, twice the injected events to also hold strays */
+    atomic_int delivered;
+    atomic_int stop;
+} Bench;
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void sleepUntilNs(uint64_t deadline)
+{
+    struct timespec ts;
+    ts.tv_sec = deadline / 1000000000ULL;
+    ts.tv_nsec = deadline % 1000000000ULL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+static void* readerThreadMain(void* arg)
+{
+    Bench* bench = (Bench*)arg;
+    struct input_event events[64];
+    struct pollfd pfd = { .fd = bench->evFd, .events = POLLIN };
+
+    while (!atomic_load(&bench->stop)) {
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+        ssize_t len = read(bench->evFd, events, sizeof(events));
+        uint64_t now = nowNs();
+        if (len <= 0) {
+            continue;
+        }
+        for (size_t i = 0; i < (size_t)len / sizeof(events[0]); i++) {
+            if (events[i].type == EV_KEY) {
+                int seq = atomic_load(&bench->delivered);
+                if (seq < bench->capacity) {
+                    bench->deliverNs[seq] = now;
+                    bench->deliverCode[seq] = events[i].code;
+                    bench->deliverValue[seq] = events[i].value;
+                }
+                atomic_store(&bench->delivered, seq + 1);
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Injection i is key benchKeys[(i / 2) % BENCH_KEY_COUNT], DOWN for even i, UP for odd i */
+static int injectedCode(int i)
+{
+    return benchKeys[(i / 2) % BENCH_KEY_COUNT];
+}
+
+/*
+ * Pair every delivery with the first later injection of the same key code
+ * and value. Delivery is in order, so injections skipped over are lost.
+ * Returns the number of matches, their latencies are stored in latency.
+ */
+static int matchDeliveries(const Bench* bench, int events, int delivered, uint64_t* latency, int* strays)
+{
+    int next = 0;
+    int matched = 0;
+
+    *strays = 0;
+    for (int d = 0; d < delivered; d++) {
+        uint32_t iCode = UINPUT_GetIARMKeyCode(bench->deliverCode[d], KEY_RESERVED);
+        int value = bench->deliverValue[d];
+        int i = next;
+
+        if ((value == 0) || (value == 1)) {
+            while ((i < events) && ((injectedCode(i) != (int)iCode) || ((i % 2) != (1 - value)))) {
+                i++;
+            }
+        } else {
+            i = events;
+        }
+        if ((i == events) || (bench->injectNs[i] > bench->deliverNs[d])) {
+            (*strays)++;
+            continue;
+        }
+        latency[matched++] = bench->deliverNs[d] - bench->injectNs[i];
+        next = i + 1;
+    }
+    return matched;
+}
+
+static int compareU64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(const uint64_t* sorted, int count, double pct)
+{
+    int index = (int)((pct / 100.0) * (count - 1) + 0.5);
+    return sorted[index] / 1000.0;
+}
+
+/* Release the evdev reader, the buffers and the uinput device */
+static void benchTerm(Bench* bench, uint64_t* latency)
+{
+    ioctl(bench->evFd, EVIOCGRAB, 0);
+    close(bench->evFd);
+    free(bench->injectNs);
+    free(bench->deliverNs);
+    free(bench->deliverCode);
+    free(bench->deliverValue);
+    free(latency);
+    UINPUT_term();
+}
+
+static void parseRates(const char* arg, int* rates, int* size)
+{
+    char buffer[256];
+    char* token;
+    int index = 0;
+
+    strncpy(buffer, arg, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    token = strtok(buffer, ",");
+    while (token != NULL && index < MAX_RATES) {
+        if (atoi(token) > 0) {
+            rates[index++] = atoi(token);
+        }
+        token = strtok(NULL, ",");
+    }
+    *size = index;
+}
+
+static void usage(const char* prog)
+{
+    printf("\nUsage: '%s [OPTIONS]'\n", prog);
+    printf("\tOptions:\n");
+    printf("\t  --keys <N>          Keys (DOWN+UP pairs) injected per rate step (default %d).\n", DEFAULT_KEYS_PER_STEP);
+    printf("\t  --rates <R1,R2,..>  Injection rates in keys/sec, as CSV (default 100 .. 20000).\n");
+    printf("\t  --p99 <MS>          p99 latency limit for a rate to count as sustainable (default %d ms).\n", DEFAULT_P99_LIMIT_MS);
+    printf("\t  --verbose           Log every injected key (slows the injection path down).\n");
+    printf("\tlost counts injected events never delivered, stray delivered events matching no injection.\n");
+}
+
+int main(int argc, char* argv[])
+{
+    struct option longOptions[] = {
+        { "keys", required_argument, NULL, 'n' },
+        { "rates", required_argument, NULL, 'r' },
+        { "p99", required_argument, NULL, 'l' },
+        { "verbose", no_argument, NULL, 'v' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    int rates[MAX_RATES];
+    int rateCount = 0;
+    int keysPerStep = DEFAULT_KEYS_PER_STEP;
+    int p99LimitMs = DEFAULT_P99_LIMIT_MS;
+    int verbose = 0;
+    int maxSustainable = 0;
+    char evNode[128] = "";
+    Bench bench;
+    uint64_t* latency = NULL;
+    pthread_t reader;
+    int opt;
+
+    memcpy(rates, defaultRates, sizeof(defaultRates));
+    rateCount = sizeof(defaultRates) / sizeof(defaultRates[0]);
+
+    while ((opt = getopt_long(argc, argv, "n:r:l:vh", longOptions, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            keysPerStep = atoi(optarg);
+            break;
+        case 'r':
+            parseRates(optarg, rates, &rateCount);
+            break;
+        case 'l':
+            p99LimitMs = atoi(optarg);
+            break;
+        case 'v':
+            verbose = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ((keysPerStep <= 0) || (rateCount == 0)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    UINPUT_init();
+    /* Per-key logging would dominate the measured path */
+    if (!verbose) {
+        keySimLogLevel = KEYSIM_LOG_ERROR;
+    }
+    uinput_dispatcher_t dispatcher = UINPUT_GetDispatcher();
+    if (dispatcher == NULL) {
+        printf("Error: uinput device could not be created\n");
+        return EXIT_FAILURE;
+    }
+
+    /* udev may need a moment to create the node for the new device */
+    memset(&bench, 0, sizeof(bench));
+    bench.evFd = -1;
+    for (int retry = 0; (retry < 20) && (bench.evFd < 0); retry++) {
+        if (UINPUT_GetDevNode(evNode, sizeof(evNode)) == 0) {
+            bench.evFd = open(evNode, O_RDONLY | O_NONBLOCK);
+        }
+        if (bench.evFd < 0) {
+            usleep(100 * 1000);
+        }
+    }
+    if (bench.evFd < 0) {
+        printf("Error: evdev node of the uinput device not found\n");
+        UINPUT_term();
+        return EXIT_FAILURE;
+    }
+    /* Keep the benchmark keys away from the running UI */
+    if (ioctl(bench.evFd, EVIOCGRAB, 1) != 0) {
+        printf("Warning: could not grab %s, keys are visible to other readers\n", evNode);
+    }
+
+    bench.capacity = keysPerStep * 4;
+    bench.injectNs = (uint64_t*)calloc((size_t)keysPerStep * 2, sizeof(uint64_t));
+    bench.deliverNs = (uint64_t*)calloc((size_t)bench.capacity, sizeof(uint64_t));
+    bench.deliverCode = (uint16_t*)calloc((size_t)bench.capacity, sizeof(uint16_t));
+    bench.deliverValue = (int32_t*)calloc((size_t)bench.capacity, sizeof(int32_t));
+    latency = (uint64_t*)calloc((size_t)bench.capacity, sizeof(uint64_t));
+    if ((bench.injectNs == NULL) || (bench.deliverNs == NULL) || (bench.deliverCode == NULL) ||
+        (bench.deliverValue == NULL) || (latency == NULL)) {
+        printf("Error: out of memory\n");
+        benchTerm(&bench, latency);
+        return EXIT_FAILURE;
+    }
+
+    printf("Benchmarking %s, %d keys per step, p99 limit %d ms\n", evNode, keysPerStep, p99LimitMs);
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s  %s\n",
+           "target/s", "actual/s", "lost", "stray", "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "max(us)", "result");
+
+    for (int step = 0; step < rateCount; step++) {
+        int events = keysPerStep * 2;
+        uint64_t period = 1000000000ULL / (uint64_t)rates[step];
+
+        atomic_store(&bench.delivered, 0);
+        atomic_store(&bench.stop, 0);
+        if (pthread_create(&reader, NULL, readerThreadMain, &bench) != 0) {
+            printf("Error: failed to create reader thread\n");
+            break;
+        }
+
+        uint64_t start = nowNs();
+        for (int key = 0; key < keysPerStep; key++) {
+            sleepUntilNs(start + (uint64_t)key * period);
+            bench.injectNs[key * 2] = nowNs();
+            dispatcher(injectedCode(key * 2), KET_KEYDOWN, 0);
+            bench.injectNs[key * 2 + 1] = nowNs();
+            dispatcher(injectedCode(key * 2 + 1), KET_KEYUP, 0);
+        }
+        uint64_t end = nowNs();
+
+        uint64_t drainDeadline = nowNs() + DRAIN_TIMEOUT_MS * 1000000ULL;
+        while ((atomic_load(&bench.delivered) < events) && (nowNs() < drainDeadline)) {
+            usleep(1000);
+        }
+        atomic_store(&bench.stop, 1);
+        pthread_join(reader, NULL);
+
+        if (UINPUT_GetDispatcher() == NULL) {
+            printf("Error: uinput device lost during the run\n");
+            break;
+        }
+
+        int delivered = atomic_load(&bench.delivered);
+        int strays = 0;
+        if (delivered > bench.capacity) {
+            delivered = bench.capacity;
+        }
+        int matched = matchDeliveries(&bench, events, delivered, latency, &strays);
+        strays += atomic_load(&bench.delivered) - delivered;
+        qsort(latency, (size_t)matched, sizeof(uint64_t), compareU64);
+
+        double actual = (end > start) ? ((double)keysPerStep * 1e9 / (double)(end - start)) : 0.0;
+        int lost = events - matched;
+        if (matched == 0) {
+            printf("%10d %10.0f %10d %10d %10s %10s %10s %10s %10s  FAIL\n", rates[step], actual, lost, strays, "-", "-", "-", "-", "-");
+            continue;
+        }
+
+        double p99 = percentileUs(latency, matched, 99.0);
+        int sustainable = (lost == 0) && (strays == 0) && (actual >= rates[step] * 0.95) && (p99 <= p99LimitMs * 1000.0);
+        if (sustainable && (rates[step] > maxSustainable)) {
+            maxSustainable = rates[step];
+        }
+        printf("%10d %10.0f %10d %10d %10.1f %10.1f %10.1f %10.1f %10.1f  %s\n",
+               rates[step], actual, lost, strays,
+               percentileUs(latency, matched, 50.0),
+               percentileUs(latency, matched, 90.0),
+               p99,
+               percentileUs(latency, matched, 99.9),
+               latency[matched - 1] / 1000.0,
+               sustainable ? "OK" : "FAIL");
+    }
+
+    printf("Maximum sustainable key rate: %d keys/sec\n", maxSustainable);
+
+    benchTerm(&bench, latency);
+    return 0;
+}
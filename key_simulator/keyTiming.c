@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <math.h>
+#include <string.h>
+
+#include "keyTiming.h"
+
+/* Linux input core defaults (REP_DELAY / REP_PERIOD) */
+#define KERNEL_REPEAT_DELAY_MS 250
+#define KERNEL_REPEAT_PERIOD_MS 33
+
+static KeyTiming_Config_t config = {
+    .profile = KEYTIMING_PROFILE_FIXED,
+    .repeatDelayMs = 50,
+    .repeatPeriodMs = 50,
+};
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+static uint32_t burstLeft = 0;
+
+/* splitmix64: small, fast and fully determined by the seed */
+static uint64_t nextRandom(void)
+{
+    uint64_t z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Uniform in (0, 1) */
+static double nextUniform(void)
+{
+    return ((nextRandom() >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/* Standard normal, Box-Muller */
+static double nextGaussian(void)
+{
+    return sqrt(-2.0 * log(nextUniform())) * cos(2.0 * M_PI * nextUniform());
+}
+
+/* Normal around mean, clamped so a key is never released before it is pressed */
+static uint64_t normalUs(uint32_t meanMs, uint32_t jitterMs)
+{
+    double ms = meanMs + (jitterMs * nextGaussian());
+    if (ms < 1.0) {
+        ms = 1.0;
+    }
+    return (uint64_t)(ms * 1000.0);
+}
+
+/* Log-normal with the given mean: right skewed like human reaction times */
+static uint64_t logNormalUs(uint32_t meanMs, uint32_t jitterMs)
+{
+    if (meanMs == 0) {
+        return 0;
+    }
+    double cv = (double)jitterMs / meanMs;
+    double sigma = sqrt(log(1.0 + (cv * cv)));
+    double ms = meanMs * exp((sigma * nextGaussian()) - (sigma * sigma / 2.0));
+    return (uint64_t)(ms * 1000.0);
+}
+
+int KeyTiming_SetProfile(const char *name)
+{
+    KeyTiming_Config_t defaults;
+
+    memset(&defaults, 0, sizeof(defaults));
+    if (strcmp(name, "fixed") == 0) {
+        defaults.profile = KEYTIMING_PROFILE_FIXED;
+        defaults.repeatDelayMs = 50;
+        defaults.repeatPeriodMs = 50;
+    } else if (strcmp(name, "human") == 0) {
+        defaults.profile = KEYTIMING_PROFILE_HUMAN;
+        defaults.repeatDelayMs = KERNEL_REPEAT_DELAY_MS;
+        defaults.repeatPeriodMs = KERNEL_REPEAT_PERIOD_MS;
+        defaults.holdMeanMs = 90;
+        defaults.holdJitterMs = 25;
+        defaults.gapMeanMs = 700;
+        defaults.gapJitterMs = 350;
+    } else if (strcmp(name, "surf") == 0) {
+        defaults.profile = KEYTIMING_PROFILE_SURF;
+        defaults.repeatDelayMs = KERNEL_REPEAT_DELAY_MS;
+        defaults.repeatPeriodMs = KERNEL_REPEAT_PERIOD_MS;
+        defaults.holdMeanMs = 70;
+        defaults.holdJitterMs = 15;
+        defaults.gapMeanMs = 250;
+        defaults.gapJitterMs = 80;
+        defaults.burstMin = 3;
+        defaults.burstMax = 8;
+        defaults.burstPauseMs = 4000;
+    } else {
+        return -1;
+    }
+    defaults.seed = config.seed;
+    config = defaults;
+    return 0;
+}
+
+KeyTiming_Config_t* KeyTiming_GetConfig(void)
+{
+    return &config;
+}
+
+void KeyTiming_Seed(uint64_t seed)
+{
+    config.seed = seed;
+    rngState = seed;
+    burstLeft = 0;
+}
+
+uint32_t KeyTiming_TapHoldUs(void)
+{
+    if (config.profile == KEYTIMING_PROFILE_FIXED) {
+        return 100;
+    }
+    return (uint32_t)normalUs(config.holdMeanMs, config.holdJitterMs);
+}
+
+uint32_t KeyTiming_RepeatDelayUs(void)
+{
+    return config.repeatDelayMs * 1000;
+}
+
+uint32_t KeyTiming_RepeatPeriodUs(void)
+{
+    return config.repeatPeriodMs * 1000;
+}
+
+uint32_t KeyTiming_RepeatCount(uint32_t holdMs)
+{
+    if ((config.repeatPeriodMs == 0) || (holdMs < config.repeatDelayMs)) {
+        return 0;
+    }
+    return ((holdMs - config.repeatDelayMs) / config.repeatPeriodMs) + 1;
+}
+
+uint64_t KeyTiming_NextGapUs(uint32_t intervalSec)
+{
+    switch (config.profile) {
+    case KEYTIMING_PROFILE_HUMAN:
+        return logNormalUs(config.gapMeanMs, config.gapJitterMs);
+
+    case KEYTIMING_PROFILE_SURF:
+        if (burstLeft == 0) {
+            uint32_t span = (config.burstMax > config.burstMin) ? (config.burstMax - config.burstMin + 1) : 1;
+            uint32_t presses = config.burstMin + (uint32_t)(nextRandom() % span);
+            /* The press after the pause is the first of the burst */
+            burstLeft = (presses > 0) ? presses - 1 : 0;
+            return logNormalUs(config.burstPauseMs, config.burstPauseMs / 2);
+        }
+        burstLeft--;
+        return logNormalUs(config.gapMeanMs, config.gapJitterMs);
+
+    case KEYTIMING_PROFILE_FIXED:
+    default:
+        return (uint64_t)intervalSec * 1000000;
+    }
+}
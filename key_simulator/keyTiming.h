@@ -0,0 +1,108 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+* @file keyTiming.h
+*
+* @brief Key press timing profiles for keySimulator.
+*
+* Decides how long a key is held, how press-and-hold repeats are paced and
+* how long to wait between keys. All randomness comes from one seeded
+* generator, so a run is reproduced exactly by passing the same seed.
+*
+*/
+
+#ifndef _KEY_TIMING_H_
+#define _KEY_TIMING_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _KeyTiming_Profile_t {
+    KEYTIMING_PROFILE_FIXED,    /*!< Legacy timing: 100us taps, 50ms repeats, fixed interval */
+    KEYTIMING_PROFILE_HUMAN,    /*!< Jittered taps and gaps, kernel style autorepeat */
+    KEYTIMING_PROFILE_SURF,     /*!< Bursts of quick presses separated by long pauses */
+} KeyTiming_Profile_t;
+
+typedef struct _KeyTiming_Config_t {
+    KeyTiming_Profile_t profile;
+    uint64_t seed;
+    uint32_t repeatDelayMs;     /*!< Hold time before the first KET_KEYREPEAT */
+    uint32_t repeatPeriodMs;    /*!< Time between KET_KEYREPEATs */
+    uint32_t holdMeanMs;        /*!< Tap: KET_KEYDOWN to KET_KEYUP */
+    uint32_t holdJitterMs;
+    uint32_t gapMeanMs;         /*!< KET_KEYUP to next KET_KEYDOWN */
+    uint32_t gapJitterMs;
+    uint32_t burstMin;          /*!< Surf: presses per burst */
+    uint32_t burstMax;
+    uint32_t burstPauseMs;      /*!< Surf: mean pause between bursts */
+} KeyTiming_Config_t;
+
+/**
+ * @brief select a profile by name (fixed, human, surf) and load its defaults.
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int KeyTiming_SetProfile(const char *name);
+
+/**
+ * @brief access the active configuration to override individual defaults.
+ */
+KeyTiming_Config_t* KeyTiming_GetConfig(void);
+
+/**
+ * @brief seed the generator; call after all overrides, before the first key.
+ */
+void KeyTiming_Seed(uint64_t seed);
+
+/**
+ * @brief tap hold time, KET_KEYDOWN to KET_KEYUP.
+ */
+uint32_t KeyTiming_TapHoldUs(void);
+
+/**
+ * @brief delay between KET_KEYDOWN and the first KET_KEYREPEAT.
+ */
+uint32_t KeyTiming_RepeatDelayUs(void);
+
+/**
+ * @brief delay between successive KET_KEYREPEATs.
+ */
+uint32_t KeyTiming_RepeatPeriodUs(void);
+
+/**
+ * @brief number of KET_KEYREPEATs a key held for holdMs would produce.
+ */
+uint32_t KeyTiming_RepeatCount(uint32_t holdMs);
+
+/**
+ * @brief wait before the next key press.
+ *
+ * @param [in] intervalSec the -i interval, used by the fixed profile.
+ */
+uint64_t KeyTiming_NextGapUs(uint32_t intervalSec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _KEY_TIMING_H_ */
@@ -63,32 +63,55 @@
 
 #ifndef _UINPUT_INTERNAL_
 #define _UINPUT_INTERNAL_
-#include "libIARM.h"
+#include <stddef.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 
-#ifdef RDK_LOGGER_ENABLED
-#include "rdk_debug.h"
-#include "iarmUtil.h"
+/* Log levels for LOG(), most severe first */
+#define KEYSIM_LOG_NONE     0
+#define KEYSIM_LOG_ERROR    1
+#define KEYSIM_LOG_INFO     2
+#define KEYSIM_LOG_DEBUG    3
 
-extern int b_rdk_logger_enabled;
+/* Compile-time ceiling, -DKEYSIM_LOG_MAX_LEVEL=KEYSIM_LOG_ERROR drops the per-key messages from the build */
+#ifndef KEYSIM_LOG_MAX_LEVEL
+#define KEYSIM_LOG_MAX_LEVEL KEYSIM_LOG_DEBUG
+#endif
+
+/* Runtime level, messages above it cost one compare and no formatting or I/O */
+extern int keySimLogLevel;
 
-#define LOG(...)              INT_LOG(__VA_ARGS__, "")
-#define INT_LOG(FORMAT, ...)     if(b_rdk_logger_enabled) {\
-RDK_LOG(RDK_LOG_DEBUG, "LOG.RDK.KEYSIMULATOR", FORMAT , __VA_ARGS__);\
+#define LOG(LEVEL, ...)     do {\
+if (((LEVEL) <= KEYSIM_LOG_MAX_LEVEL) && ((LEVEL) <= keySimLogLevel)) {\
+KeySimLog_Write((LEVEL), __VA_ARGS__);\
 }\
-else\
-{\
-printf(FORMAT, __VA_ARGS__);\
-}
+} while (0)
 
-#else
+/**
+ * @brief log module init.
+ *
+ * Reads KEYSIM_LOG_LEVEL (0-3) and KEYSIM_LOG_RING (1 keeps messages in an
+ * in-memory ring buffer instead of writing them, the ring is dumped to
+ * stderr on exit).
+ */
+void KeySimLog_Init(void);
 
-#define LOG(...)              printf(__VA_ARGS__)
+/**
+ * @brief send messages to the in-memory ring (true) or the console (false).
+ */
+void KeySimLog_SetRing(bool enable);
 
-#endif
+/**
+ * @brief write one message, use LOG() rather than calling this directly.
+ */
+void KeySimLog_Write(int level, const char *format, ...) __attribute__((format(printf, 2, 3)));
 
+/**
+ * @brief write the ring buffer content to stderr and empty it.
+ */
+void KeySimLog_Dump(void);
 
 
 typedef void (* uinput_dispatcher_t) (int keyCode, int keyType, int source);
@@ -109,6 +132,29 @@ int UINPUT_init(void);
  */
 uinput_dispatcher_t UINPUT_GetDispatcher(void);
 
+/**
+ * @brief reverse of the IARM to Linux key mapping
+ *
+ * @param [in] uCode Linux key code (KEY_*).
+ * @param [in] uModi Linux modifier held with it, KEY_RESERVED for none.
+ *
+ * @return the first IARM key code (KED_*) mapped to that combination,
+ *         KED_UNDEFINEDKEY if there is none.
+ */
+uint32_t UINPUT_GetIARMKeyCode(uint32_t uCode, uint32_t uModi);
+
+/**
+ * @brief get the evdev node (/dev/input/eventX) of the created uinput device
+ *
+ * Lets a reader observe the events injected through the dispatcher.
+ *
+ * @param [out] path buffer receiving the node path.
+ * @param [in] len size of path.
+ *
+ * @return 0 on success, -1 if the device or its node cannot be found.
+ */
+int UINPUT_GetDevNode(char *path, size_t len);
+
 /**
  * @brief uinput module term.
  *
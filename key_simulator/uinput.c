@@ -23,9 +23,11 @@
 
 #include <linux/uinput.h>
 #include <linux/input.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 #include "uInputInternal.h"
@@ -50,7 +52,7 @@ static uint32_t getKeyCode(uint32_t keycode, uint32_t *uCode, uint32_t *uModi)
 {
     unsigned char i;
 
-    printf("%s %d uinput received Key code %d 0x%x \r\n", __FUNCTION__, __LINE__, keycode, keycode);
+    LOG(KEYSIM_LOG_DEBUG, "%s %d uinput received Key code %d 0x%x \r\n", __FUNCTION__, __LINE__, keycode, keycode);
     for (i=0; i < (sizeof(kcodesMap_IARM2Linux)/sizeof(kcodesMap_IARM2Linux[0])); i++)
     {   
         if (kcodesMap_IARM2Linux[i].iCode == keycode)
@@ -61,7 +63,7 @@ static uint32_t getKeyCode(uint32_t keycode, uint32_t *uCode, uint32_t *uModi)
         }   
     }   
 
-    printf("UNrecognized Key code %d \r\n", keycode);
+    LOG(KEYSIM_LOG_ERROR, "UNrecognized Key code %d \r\n", keycode);
     return KED_UNDEFINEDKEY;
 }
 
@@ -77,7 +79,7 @@ static uint32_t getKeyValue(uint32_t keyType)
         case KET_KEYREPEAT:
             return 2;
         default:
-            printf("UNrecognized Key type %d \r\n", keyType);
+            LOG(KEYSIM_LOG_ERROR, "UNrecognized Key type %d \r\n", keyType);
     }
 
     return 0;
@@ -88,7 +90,7 @@ static void udispatcher_internal(int code, int value)
     int ret = -1;
     struct input_event ev;
 
-    printf("%d:%s: code=%d , value=%d\n", __LINE__, __func__, code, value);
+    LOG(KEYSIM_LOG_DEBUG, "%d:%s: code=%d , value=%d\n", __LINE__, __func__, code, value);
     memset(&ev, 0, sizeof(ev));
     gettimeofday(&ev.time, NULL);
     ev.type = EV_KEY;
@@ -111,7 +113,7 @@ static void udispatcher_internal(int code, int value)
 
 static void udispatcher (int keyCode, int keyType, int source)
 {
-    printf("%s %d uinput received Key code= %d 0x%x  keyType= %d 0x%x \r\n", __FUNCTION__, __LINE__, keyCode, keyCode, keyType, keyType);
+    LOG(KEYSIM_LOG_DEBUG, "%s %d uinput received Key code= %d 0x%x  keyType= %d 0x%x \r\n", __FUNCTION__, __LINE__, keyCode, keyCode, keyType, keyType);
     if (devFd >= 0) {
         static const char * type2str[] = {"KEY_UP", "KEY_DOWN", "KEY_REPEAT"};
         uint32_t uCode = _KEY_INVALID;
@@ -120,7 +122,7 @@ static void udispatcher (int keyCode, int keyType, int source)
 
         getKeyCode(keyCode, &uCode, &uModi);
         value = getKeyValue(keyType);
-        printf("IR-Keyboard Regular Key: IR=%x key=%x Modifier=%x val=%x [%s]\r\n", keyCode, uCode, uModi, value, type2str[value]);
+        LOG(KEYSIM_LOG_DEBUG, "IR-Keyboard Regular Key: IR=%x key=%x Modifier=%x val=%x [%s]\r\n", keyCode, uCode, uModi, value, type2str[value]);
         /*
          *  Send Modifier KEY_DOWN and KEY_UP event
          *  along with keycode's DOWN and UP event.
@@ -150,9 +152,10 @@ int UINPUT_init(void)
 
     int fd = -1;
     int ret = -1;
+    KeySimLog_Init();
     fd = open("/dev/uinput", O_WRONLY|O_SYNC);
     if (fd >= 0) {
-        printf("Linux uinput version [%d] is built-in with kernel\r\n", UINPUT_VERSION);
+        LOG(KEYSIM_LOG_INFO, "Linux uinput version [%d] is built-in with kernel\r\n", UINPUT_VERSION);
         /* Fist setup input capabilities*/
         {
             //Add event types
@@ -185,7 +188,7 @@ int UINPUT_init(void)
             struct uinput_user_dev uidev;
             UINPUT_SETUP_ID(uidev);
             ret = write(fd, &uidev, sizeof(uidev));
-            printf("write uinput_user_dev return %d vs %d\r\n", ret, sizeof(uidev));
+            LOG(KEYSIM_LOG_INFO, "write uinput_user_dev return %d vs %zu\r\n", ret, sizeof(uidev));
             ret = ((ret == sizeof(uidev)) ? 0 :  -1);
         }
 #endif
@@ -208,7 +211,7 @@ int UINPUT_init(void)
         }
     }
     else {
-        printf("Linux uinput is not built-in with kernel\r\n");
+        LOG(KEYSIM_LOG_ERROR, "Linux uinput is not built-in with kernel\r\n");
     }
 
     devFd = fd;
@@ -221,6 +224,86 @@ uinput_dispatcher_t UINPUT_GetDispatcher(void)
     else return NULL;
 }
 
+uint32_t UINPUT_GetIARMKeyCode(uint32_t uCode, uint32_t uModi)
+{
+    for (size_t i = 0; i < sizeof(kcodesMap_IARM2Linux)/sizeof(kcodesMap_IARM2Linux[0]); i++) {
+        if ((kcodesMap_IARM2Linux[i].uCode == uCode) && (kcodesMap_IARM2Linux[i].uModi == uModi)) {
+            return kcodesMap_IARM2Linux[i].iCode;
+        }
+    }
+    return KED_UNDEFINEDKEY;
+}
+
+int UINPUT_GetDevNode(char *path, size_t len)
+{
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    char name[UINPUT_MAX_NAME_SIZE];
+    int found = -1;
+
+    if ((devFd < 0) || (path == NULL) || (len == 0)) {
+        return -1;
+    }
+
+#ifdef UI_GET_SYSNAME
+    {
+        char sysname[64] = {0};
+        char sysdir[128];
+
+        /* The kernel names the created device; its event node lives below it in sysfs */
+        if (ioctl(devFd, UI_GET_SYSNAME(sizeof(sysname)), sysname) >= 0) {
+            snprintf(sysdir, sizeof(sysdir), "/sys/devices/virtual/input/%s", sysname);
+            dir = opendir(sysdir);
+            if (dir != NULL) {
+                while ((entry = readdir(dir)) != NULL) {
+                    if (strncmp(entry->d_name, "event", 5) == 0) {
+                        snprintf(path, len, "/dev/input/%s", entry->d_name);
+                        found = 0;
+                        break;
+                    }
+                }
+                closedir(dir);
+            }
+        }
+        if (found == 0) {
+            return 0;
+        }
+    }
+#endif
+
+    /* Older uinput: match the evdev nodes against the id set in UINPUT_init */
+    dir = opendir("/dev/input");
+    if (dir == NULL) {
+        return -1;
+    }
+    while ((found != 0) && ((entry = readdir(dir)) != NULL)) {
+        char node[300];
+        struct input_id id;
+        int fd = -1;
+
+        if (strncmp(entry->d_name, "event", 5) != 0) {
+            continue;
+        }
+        snprintf(node, sizeof(node), "/dev/input/%s", entry->d_name);
+        fd = open(node, O_RDONLY | O_NONBLOCK);
+        if (fd < 0) {
+            continue;
+        }
+        memset(name, 0, sizeof(name));
+        if ((ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) >= 0) &&
+            (ioctl(fd, EVIOCGID, &id) >= 0) &&
+            (strcmp(name, "key-simulator") == 0) &&
+            (id.vendor == 0xbeef) && (id.product == 0xfedc)) {
+            snprintf(path, len, "%s", node);
+            found = 0;
+        }
+        close(fd);
+    }
+    closedir(dir);
+
+    return found;
+}
+
 int UINPUT_term()
 {
     if (devFd >= 0) 
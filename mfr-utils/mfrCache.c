@@ -0,0 +1,261 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mfrCache.h"
+
+#define BOOT_ID_FILE "/proc/sys/kernel/random/boot_id"
+
+typedef struct {
+    uint32_t type;
+    MfrCache_Scope_t scope;
+    size_t length;
+    char* value;                    /* NUL terminated */
+} Entry;
+
+static Entry entries[MFR_CACHE_MAX_ENTRIES];
+static int entryCount = 0;
+static char bootId[MFR_CACHE_BOOT_ID_SIZE] = "";
+static bool dirty = false;
+static bool permanentDirty = false;
+
+static void readBootId(void)
+{
+    int fd = open(BOOT_ID_FILE, O_RDONLY | O_CLOEXEC);
+    ssize_t len;
+
+    bootId[0] = '\0';
+    if (fd < 0) {
+        return;
+    }
+    len = read(fd, bootId, sizeof(bootId) - 1);
+    close(fd);
+    if (len <= 0) {
+        bootId[0] = '\0';
+        return;
+    }
+    bootId[len] = '\0';
+    bootId[strcspn(bootId, "\n")] = '\0';
+}
+
+static Entry* findEntry(uint32_t type)
+{
+    for (int i = 0; i < entryCount; i++) {
+        if (entries[i].type == type) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void setEntry(uint32_t type, MfrCache_Scope_t scope, const char* value, size_t length)
+{
+    Entry* entry = findEntry(type);
+    char* copy = (char*)malloc(length + 1);
+
+    if (copy == NULL) {
+        return;
+    }
+    memcpy(copy, value, length);
+    copy[length] = '\0';
+
+    if (entry == NULL) {
+        if (entryCount == MFR_CACHE_MAX_ENTRIES) {
+            free(copy);
+            return;
+        }
+        entry = &entries[entryCount++];
+    } else {
+        free(entry->value);
+    }
+    entry->type = type;
+    entry->scope = scope;
+    entry->length = length;
+    entry->value = copy;
+}
+
+/* Returns the number of entries taken from path, -1 if it is not a usable cache */
+static int loadFile(const char* path, bool permanentOnly)
+{
+    static uint8_t buf[MFR_CACHE_MAX_SIZE];
+    MfrCache_Header_t header;
+    bool sameBoot;
+    struct stat st;
+    size_t offset;
+    ssize_t len;
+    int fd, taken = 0;
+
+    fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    /* Only trust a cache this user wrote */
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_uid != geteuid())) {
+        close(fd);
+        return -1;
+    }
+    len = read(fd, buf, sizeof(buf));
+    close(fd);
+    if (len < (ssize_t)sizeof(header)) {
+        return -1;
+    }
+    memcpy(&header, buf, sizeof(header));
+    if ((header.magic != MFR_CACHE_MAGIC) || (header.version != MFR_CACHE_VERSION)) {
+        return -1;
+    }
+    sameBoot = (bootId[0] != '\0') && (strncmp(header.bootId, bootId, sizeof(header.bootId)) == 0);
+
+    offset = sizeof(header);
+    for (uint32_t i = 0; i < header.count; i++) {
+        MfrCache_Record_t record;
+
+        if (offset + sizeof(record) > (size_t)len) {
+            return -1;
+        }
+        memcpy(&record, buf + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.length > (size_t)len - offset) {
+            return -1;
+        }
+        if ((record.scope == MFR_CACHE_PERMANENT) || (!permanentOnly && sameBoot)) {
+            setEntry(record.type, (MfrCache_Scope_t)record.scope, (const char*)buf + offset, record.length);
+            taken++;
+        }
+        offset += record.length;
+    }
+    return taken;
+}
+
+/* Write the entries of the wanted scope (or all) to path through a rename */
+static void saveFile(const char* path, bool permanentOnly, bool durable)
+{
+    MfrCache_Header_t header;
+    char tmpPath[256];
+    FILE* out;
+    int fd;
+    bool ok = true;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = MFR_CACHE_MAGIC;
+    header.version = MFR_CACHE_VERSION;
+    memcpy(header.bootId, bootId, sizeof(header.bootId));
+    for (int i = 0; i < entryCount; i++) {
+        if (!permanentOnly || (entries[i].scope == MFR_CACHE_PERMANENT)) {
+            header.count++;
+        }
+    }
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d", path, (int)getpid());
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+    if ((fd < 0) || ((out = fdopen(fd, "wb")) == NULL)) {
+        if (fd >= 0) {
+            close(fd);
+            unlink(tmpPath);
+        }
+        return;
+    }
+
+    ok = (fwrite(&header, sizeof(header), 1, out) == 1);
+    for (int i = 0; ok && (i < entryCount); i++) {
+        MfrCache_Record_t record;
+
+        if (permanentOnly && (entries[i].scope != MFR_CACHE_PERMANENT)) {
+            continue;
+        }
+        record.type = entries[i].type;
+        record.scope = entries[i].scope;
+        record.length = (uint32_t)entries[i].length;
+        ok = (fwrite(&record, sizeof(record), 1, out) == 1) &&
+             ((record.length == 0) || (fwrite(entries[i].value, record.length, 1, out) == 1));
+    }
+    ok = (fflush(out) == 0) && ok;
+    /* The persistent copy is on flash, make it survive a power cut */
+    if (ok && durable) {
+        ok = (fsync(fd) == 0);
+    }
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || (rename(tmpPath, path) != 0)) {
+        unlink(tmpPath);
+    }
+}
+
+void MfrCache_Load(void)
+{
+    readBootId();
+    if (loadFile(MFR_CACHE_FILE, false) > 0) {
+        return;
+    }
+#if defined(MFR_UTIL_PERSISTENT_CACHE)
+    /* First run after a reboot, or a tmpfs cache holding nothing usable:
+       seed it with the values that never change */
+    if (loadFile(MFR_UTIL_PERSISTENT_CACHE, true) > 0) {
+        dirty = true;
+    }
+#endif
+}
+
+const char* MfrCache_Get(uint32_t type)
+{
+    Entry* entry = findEntry(type);
+    return (entry != NULL) ? entry->value : NULL;
+}
+
+void MfrCache_Put(uint32_t type, MfrCache_Scope_t scope, const char* value, size_t length)
+{
+    Entry* entry = findEntry(type);
+
+    /* Boot scoped values are useless without a boot ID to check them against */
+    if ((scope == MFR_CACHE_BOOT) && (bootId[0] == '\0')) {
+        return;
+    }
+    if ((entry != NULL) && (entry->scope == scope) && (entry->length == length) &&
+        (memcmp(entry->value, value, length) == 0)) {
+        return;
+    }
+    setEntry(type, scope, value, length);
+    dirty = true;
+    if (scope == MFR_CACHE_PERMANENT) {
+        permanentDirty = true;
+    }
+}
+
+void MfrCache_Save(void)
+{
+    if (dirty) {
+        saveFile(MFR_CACHE_FILE, false, false);
+    }
+#if defined(MFR_UTIL_PERSISTENT_CACHE)
+    if (permanentDirty) {
+        saveFile(MFR_UTIL_PERSISTENT_CACHE, true, true);
+    }
+#endif
+    for (int i = 0; i < entryCount; i++) {
+        free(entries[i].value);
+    }
+    entryCount = 0;
+    dirty = false;
+    permanentDirty = false;
+}
@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Cache of the manufacturer data mfr_util fetched from mfrMgr.
+ *
+ * The cache lives in tmpfs and is read with a single read(). Values with
+ * MFR_CACHE_BOOT scope (image names) are tagged with the kernel boot ID
+ * and dropped after a reboot; MFR_CACHE_PERMANENT values (model, hardware
+ * ID, ...) never change for the life of the box. When built with
+ * MFR_UTIL_PERSISTENT_CACHE set to a path, the permanent values are also
+ * kept there and seed the tmpfs cache after a reboot.
+ *
+ * File layout: MfrCache_Header_t, then count records of
+ * MfrCache_Record_t followed by length bytes of value.
+ */
+#ifndef _MFR_CACHE_H_
+#define _MFR_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MFR_CACHE_FILE "/tmp/.mfr_util.cache"
+#define MFR_CACHE_MAGIC 0x4352464d /* "MFRC" */
+#define MFR_CACHE_VERSION 1
+#define MFR_CACHE_MAX_ENTRIES 16
+#define MFR_CACHE_MAX_SIZE (64 * 1024)
+#define MFR_CACHE_BOOT_ID_SIZE 40
+
+typedef enum _MfrCache_Scope_t {
+    MFR_CACHE_BOOT = 0,             /*!< Valid until the next reboot */
+    MFR_CACHE_PERMANENT = 1,        /*!< Valid for the life of the box */
+} MfrCache_Scope_t;
+
+typedef struct _MfrCache_Header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    char bootId[MFR_CACHE_BOOT_ID_SIZE];
+} MfrCache_Header_t;
+
+typedef struct _MfrCache_Record_t {
+    uint32_t type;                  /*!< mfrSerializedType_t */
+    uint32_t scope;                 /*!< MfrCache_Scope_t */
+    uint32_t length;
+} MfrCache_Record_t;
+
+/* Read the cache, falling back to the persistent copy after a reboot */
+void MfrCache_Load(void);
+
+/* Cached value of a type, NULL if there is none for this boot */
+const char* MfrCache_Get(uint32_t type);
+
+/* Remember a value fetched from mfrMgr */
+void MfrCache_Put(uint32_t type, MfrCache_Scope_t scope, const char* value, size_t length);
+
+/* Write back what Put changed, then free the cache */
+void MfrCache_Save(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MFR_CACHE_H_ */
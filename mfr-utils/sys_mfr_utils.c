@@ -29,6 +29,7 @@
 #include "mfrMgr.h"
 #include "libIBus.h"
 #include "mfrApi.h"
+#include "mfrCache.h"
 
 #if defined(YOCTO_BUILD)
     const char* validParams[] = {"--CurrentImageFilename", "--FlashedFilename", "--Modelname", "--HardwareId", "--Manufacturer", "--MfgSerialnumber", "--PDRIVersion"};
@@ -44,8 +45,24 @@ const mfrSerializedType_t mfr_args[] = {mfrSERIALIZED_TYPE_IMAGENAME, mfrSERIALI
 const char* mfr_args_str[] = {"mfrSERIALIZED_TYPE_IMAGENAME", "mfrSERIALIZED_TYPE_IMAGENAME", "mfrSERIALIZED_TYPE_MODELNAME", "mfrSERIALIZED_TYPE_HWID", "mfrSERIALIZED_TYPE_MANUFACTURER", "mfrSERIALIZED_TYPE_MANUFACTURING_SERIALNUMBER", "mfrSERIALIZED_TYPE_PDRIVERSION"}; 
 
 
+#define MAX_PARAMS (sizeof(mfr_args) / sizeof(mfr_args[0]))
+
+/* Print value in single quotes, so a Name=value line can be eval'd by a shell */
+static void printShellQuoted(const char* value)
+{
+    putchar('\'');
+    for (; *value != '\0'; value++) {
+        if (*value == '\'') {
+            fputs("'\\''", stdout);
+        } else {
+            putchar(*value);
+        }
+    }
+    putchar('\'');
+}
+
 void displayHelp() {
-     printf("Usage : mfr_util [CMD] \n");
+     printf("Usage : mfr_util [CMD]... \n");
      printf("CMDs are \n" );
      printf("%5s -> %s \n","--help", "print this help.");
      printf("%5s -> %s \n","--CurrentImageFilename", "Get current running imagename ");
@@ -57,7 +74,9 @@ void displayHelp() {
 #if defined(YOCTO_BUILD)
      printf("%5s -> %s \n","--PDRIVersion", "Get current PDRIVersion ");
 #endif
-
+     printf("%5s -> %s \n","--all", "Get all of the above");
+     printf("%5s -> %s \n","--no-cache", "Ask mfrMgr even if the value is cached, and refresh the cache");
+     printf("With more than one CMD, or --all, every value is printed as a Name='value' line, quoted for the shell\n");
 }
 
 /**
@@ -76,79 +95,189 @@ int validateParams(const char* param) {
     return paramIndex;
 }
 
-int main(int argc, char *argv[])
+/* Image names change with every flash, the rest is burnt in at the factory */
+static MfrCache_Scope_t cacheScope(mfrSerializedType_t type)
 {
-    int paramIndex = 0;
-    char *mfrReadBuf = NULL;
+    return ((type == mfrSERIALIZED_TYPE_IMAGENAME) || (type == mfrSERIALIZED_TYPE_PDRIVERSION)) ?
+           MFR_CACHE_BOOT : MFR_CACHE_PERMANENT;
+}
 
-    if (argc != 2) {
-        displayHelp();
-        return -1;
+/**
+   Fetch the requested parameters that are not in values[] yet over one IARM
+   connection and one param buffer. A type asked for twice (both image names)
+   is only fetched once.
+**/
+static void queryParams(const int* paramIndexes, int count, char** values, IARM_Result_t* results)
+{
+    IARM_Bus_MFRLib_GetSerializedData_Param_t *param = NULL;
+    int i, j;
+
+    IARM_Bus_Init("mfr_util");
+    IARM_Bus_Connect();
+    if (IARM_Malloc(IARM_MEMTYPE_PROCESSLOCAL, sizeof(IARM_Bus_MFRLib_GetSerializedData_Param_t), (void**)&param) != IARM_RESULT_SUCCESS) {
+        param = NULL;
     }
 
-    paramIndex = validateParams(argv[1]);
-    if( paramIndex == -1 ){
-        displayHelp();
-        return -1;
+    for (i = 0; i < count; i++) {
+        mfrSerializedType_t type = mfr_args[paramIndexes[i]];
+
+        if (values[i] != NULL) {
+            continue;
+        }
+        results[i] = IARM_RESULT_OOM;
+        for (j = 0; j < i; j++) {
+            if (mfr_args[paramIndexes[j]] == type) {
+                break;
+            }
+        }
+        if (j < i) {
+            results[i] = results[j];
+            values[i] = (values[j] != NULL) ? strdup(values[j]) : NULL;
+            continue;
+        }
+        if (param == NULL) {
+            continue;
+        }
+
+        memset(param, 0, sizeof(IARM_Bus_MFRLib_GetSerializedData_Param_t));
+        param->type = type;
+        results[i] = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME,
+                  IARM_BUS_MFRLIB_API_GetSerializedData,
+                  (void *)param,
+                  sizeof(IARM_Bus_MFRLib_GetSerializedData_Param_t));
+
+        if ((IARM_RESULT_SUCCESS == results[i]) && (param->bufLen >= 0) &&
+            ((size_t)param->bufLen <= sizeof(param->buffer))) {
+            values[i] = (char *)malloc(param->bufLen + 1);
+            if (NULL != values[i]) {
+                memcpy(values[i], param->buffer, param->bufLen);
+                values[i][param->bufLen] = '\0';
+            }
+        }
     }
 
-    IARM_Bus_MFRLib_GetSerializedData_Param_t *param;
-    IARM_Result_t ret;
+    if (param != NULL) {
+        IARM_Free(IARM_MEMTYPE_PROCESSLOCAL, param);
+    }
+    IARM_Bus_Disconnect();
+    IARM_Bus_Term();
+}
 
-    //redirect stdout to null to avoid printing debug prints from IARM Bus
-    int fp_old = dup(1);  // preserve the original stdout
-    if(fp_old == -1) {
-        printf("dup() failed to preserve stdout\n");
-        return -1;
+int main(int argc, char *argv[])
+{
+    int paramIndexes[MAX_PARAMS];
+    char *values[MAX_PARAMS];
+    IARM_Result_t results[MAX_PARAMS];
+    int count = 0;
+    int paramArgs = 0;
+    int batch = 0;
+    int useCache = 1;
+    int misses = 0;
+    int failed = 0;
+    int i, j;
+
+    for (i = 1; i < argc; i++) {
+        int first = i, last = i;
+        int paramIndex;
+
+        if (strcmp(argv[i], "--no-cache") == 0) {
+            useCache = 0;
+            continue;
+        }
+        paramArgs++;
+        if (strcmp(argv[i], "--all") == 0) {
+            batch = 1;
+            first = 0;
+            last = numberOfParams - 1;
+        } else {
+            paramIndex = validateParams(argv[i]);
+            if( paramIndex == -1 ){
+                displayHelp();
+                return -1;
+            }
+            first = last = paramIndex;
+        }
+        for (paramIndex = first; paramIndex <= last; paramIndex++) {
+            for (j = 0; j < count; j++) {
+                if (paramIndexes[j] == paramIndex) {
+                    break;
+                }
+            }
+            if (j == count) {
+                paramIndexes[count++] = paramIndex;
+            }
+        }
     }
-    if(freopen ("/dev/null", "w", stdout) == NULL){
-        printf("freopen() failed to redirect stdout\n");
-        close(fp_old);
+    if (paramArgs == 0) {
+        displayHelp();
         return -1;
     }
+    batch |= (paramArgs > 1);
 
-    IARM_Bus_Init("mfr_util");
-    IARM_Bus_Connect();
-    IARM_Malloc(IARM_MEMTYPE_PROCESSLOCAL, sizeof(IARM_Bus_MFRLib_GetSerializedData_Param_t), (void**)&param);
-
-    param->type = mfr_args[paramIndex];;
-
-    ret = IARM_Bus_Call(IARM_BUS_MFRLIB_NAME,
-              IARM_BUS_MFRLIB_API_GetSerializedData,
-              (void *)param,
-              sizeof(IARM_Bus_MFRLib_GetSerializedData_Param_t));
-
-    if(IARM_RESULT_SUCCESS == ret)
-    {
-       int len = param->bufLen + 1;
-       mfrReadBuf = (char *)malloc(len);
-       if(NULL != mfrReadBuf) {
-        memset(mfrReadBuf,0,len);
-        memcpy(mfrReadBuf,param->buffer,param->bufLen);
-       }
+    MfrCache_Load();
+    for (i = 0; i < count; i++) {
+        const char* cached = useCache ? MfrCache_Get(mfr_args[paramIndexes[i]]) : NULL;
+
+        values[i] = (cached != NULL) ? strdup(cached) : NULL;
+        results[i] = IARM_RESULT_SUCCESS;
+        if (values[i] == NULL) {
+            misses++;
+        }
     }
-    IARM_Free(IARM_MEMTYPE_PROCESSLOCAL,param);
 
-    IARM_Bus_Disconnect();
-    IARM_Bus_Term();
+    if (misses > 0) {
+        //redirect stdout to null to avoid printing debug prints from IARM Bus
+        int fp_old = dup(1);  // preserve the original stdout
+        if(fp_old == -1) {
+            printf("dup() failed to preserve stdout\n");
+            return -1;
+        }
+        if(freopen ("/dev/null", "w", stdout) == NULL){
+            printf("freopen() failed to redirect stdout\n");
+            close(fp_old);
+            return -1;
+        }
 
-    fflush(stdout); // ensure buffer is flushed
-    // restore original stdout
-    if (dup2(fp_old, fileno(stdout)) == -1) {
-        printf("dup2() failed to restore stdout\n");
+        queryParams(paramIndexes, count, values, results);
+
+        fflush(stdout); // ensure buffer is flushed
+        // restore original stdout
+        if (dup2(fp_old, fileno(stdout)) == -1) {
+            printf("dup2() failed to restore stdout\n");
+            close(fp_old);
+            return -1;
+        }
         close(fp_old);
-        return -1;
-    }
-    close(fp_old);
 
-    if ( NULL == mfrReadBuf) {
-        printf("Call failed for %s: error code:%d\n", mfr_args_str[paramIndex], ret);
+        /* Only what mfrMgr answered is cached, never a failure or an empty
+           value from an mfrMgr that is not ready yet */
+        for (i = 0; i < count; i++) {
+            if ((values[i] != NULL) && (values[i][0] != '\0')) {
+                mfrSerializedType_t type = mfr_args[paramIndexes[i]];
+                MfrCache_Put(type, cacheScope(type), values[i], strlen(values[i]));
+            }
+        }
     }
-    else {
-        printf("%s\n", mfrReadBuf);
-        free(mfrReadBuf);
-        mfrReadBuf = NULL;
+    MfrCache_Save();
+
+    for (i = 0; i < count; i++) {
+        if ( NULL == values[i]) {
+            /* Keep the Name=value lines parseable, failures go to stderr */
+            fprintf(batch ? stderr : stdout, "Call failed for %s: error code:%d\n",
+                    mfr_args_str[paramIndexes[i]], results[i]);
+            failed = 1;
+        }
+        else if (batch) {
+            printf("%s=", validParams[paramIndexes[i]] + 2);
+            printShellQuoted(values[i]);
+            printf("\n");
+        }
+        else {
+            printf("%s\n", values[i]);
+        }
+        free(values[i]);
+        values[i] = NULL;
     }
 
-    return 0;
-}
\ No newline at end of file
+    return (batch && failed) ? 1 : 0;
+}
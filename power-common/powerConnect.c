@@ -0,0 +1,209 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "power_controller.h"
+#include "powerConnect.h"
+
+#define BACKOFF_MIN_MS 50
+#define BACKOFF_MAX_MS 5000
+
+static pthread_mutex_t connectLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t connectOnce = PTHREAD_ONCE_INIT;
+static pthread_cond_t connectCond;
+static bool operational = false;
+static uint32_t notifications = 0;
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+/* The condition waits on CLOCK_MONOTONIC, so wall clock changes at boot do not matter */
+static void initCondition(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&connectCond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static void onOperationalStateChange(bool isOperational, void* userdata)
+{
+    pthread_mutex_lock(&connectLock);
+    operational = isOperational;
+    notifications++;
+    pthread_cond_signal(&connectCond);
+    pthread_mutex_unlock(&connectLock);
+}
+
+/* Wait up to ms for the notification, returns true if it reported operational.
+   The notification is used up, a Connect failing after it backs off again */
+static bool waitNotification(uint32_t ms)
+{
+    struct timespec deadline;
+    bool result;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&connectLock);
+    while (!operational && (pthread_cond_timedwait(&connectCond, &connectLock, &deadline) == 0)) {
+    }
+    result = operational;
+    operational = false;
+    pthread_mutex_unlock(&connectLock);
+    return result;
+}
+
+static const char* statusText(uint32_t status)
+{
+    if (POWER_CONTROLLER_ERROR_UNAVAILABLE == status) {
+        return "Thunder is UNAVAILABLE";
+    } else if (POWER_CONTROLLER_ERROR_NOT_EXIST == status) {
+        return "PowerManager is UNAVAILABLE";
+    }
+    return "Unknown error";
+}
+
+uint32_t PowerConnect_Wait(uint32_t timeoutMs, PowerConnect_Stats_t* stats)
+{
+    return PowerConnect_WaitCancellable(timeoutMs, stats, NULL, NULL);
+}
+
+bool PowerConnect_SignalPending(void* signals)
+{
+    const sigset_t* wanted = (const sigset_t*)signals;
+    sigset_t pending;
+
+    if (sigpending(&pending) != 0) {
+        return false;
+    }
+    for (int sig = 1; sig < NSIG; sig++) {
+        if (sigismember(wanted, sig) == 1 && sigismember(&pending, sig) == 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t PowerConnect_WaitCancellable(uint32_t timeoutMs, PowerConnect_Stats_t* stats,
+                                      PowerConnect_Cancel_t cancel, void* userdata)
+{
+    uint64_t start = monotonic_us();
+    uint32_t backoff = BACKOFF_MIN_MS;
+    uint32_t status = POWER_CONTROLLER_ERROR_GENERAL;
+    uint32_t lastStatus = POWER_CONTROLLER_ERROR_NONE;
+    uint32_t attempts = 0;
+    unsigned int seed = (unsigned int)(start ^ (uint64_t)getpid());
+
+    pthread_once(&connectOnce, initCondition);
+    pthread_mutex_lock(&connectLock);
+    operational = false;
+    notifications = 0;
+    pthread_mutex_unlock(&connectLock);
+
+    PowerController_RegisterOperationalStateChangeCallback(onOperationalStateChange, NULL);
+
+    while (1) {
+        uint32_t elapsedMs, delay;
+        bool notified = false;
+
+        if ((cancel != NULL) && cancel(userdata)) {
+            status = POWER_CONNECT_CANCELLED;
+            break;
+        }
+        if (PowerController_IsOperational()) {
+            status = POWER_CONTROLLER_ERROR_NONE;
+            break;
+        }
+        status = PowerController_Connect();
+        attempts++;
+        if (POWER_CONTROLLER_ERROR_NONE == status) {
+            break;
+        }
+        /* Only report changes, not every retry */
+        if (status != lastStatus) {
+            fprintf(stderr, "Failed :: Connect :: %s, waiting for PowerController\n", statusText(status));
+            lastStatus = status;
+        }
+
+        elapsedMs = (uint32_t)((monotonic_us() - start) / 1000);
+        if ((timeoutMs > 0) && (elapsedMs >= timeoutMs)) {
+            break;
+        }
+
+        /* Equal jitter: half the backoff fixed, half random, so clients
+           started together do not retry in lock step */
+        delay = (backoff / 2) + (uint32_t)(rand_r(&seed) % ((backoff / 2) + 1));
+        if ((timeoutMs > 0) && (delay > timeoutMs - elapsedMs)) {
+            delay = timeoutMs - elapsedMs;
+        }
+        /* With a cancel check, wait in short steps so it is seen in time */
+        while (!notified && (delay > 0)) {
+            uint32_t step = ((cancel != NULL) && (delay > POWER_CONNECT_CANCEL_CHECK_MS)) ? POWER_CONNECT_CANCEL_CHECK_MS : delay;
+
+            notified = waitNotification(step);
+            delay -= step;
+            if ((cancel != NULL) && !notified && (delay > 0) && cancel(userdata)) {
+                break;
+            }
+        }
+        if (notified) {
+            /* Notified: connect right away, and from the shortest backoff
+               again should that still fail */
+            backoff = BACKOFF_MIN_MS;
+            continue;
+        }
+        backoff = (backoff * 2 > BACKOFF_MAX_MS) ? BACKOFF_MAX_MS : backoff * 2;
+    }
+
+    PowerController_UnRegisterOperationalStateChangeCallback(onOperationalStateChange);
+
+    if (stats != NULL) {
+        stats->elapsedUs = monotonic_us() - start;
+        stats->attempts = attempts;
+        pthread_mutex_lock(&connectLock);
+        stats->notifications = notifications;
+        pthread_mutex_unlock(&connectLock);
+        stats->lastStatus = status;
+    }
+    if (POWER_CONTROLLER_ERROR_NONE == status) {
+        fprintf(stderr, "Success :: Connect :: operational after %llu ms, %u attempts\n",
+                (unsigned long long)((monotonic_us() - start) / 1000), attempts);
+    }
+    return status;
+}
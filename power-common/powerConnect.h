@@ -0,0 +1,76 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Connect to the PowerManager plugin without busy polling.
+ *
+ * PowerConnect_Wait sleeps until the OperationalStateChange notification
+ * arrives, and only retries PowerController_Connect on an exponential
+ * backoff with jitter in case the notification never comes (Thunder
+ * itself not up yet). Progress goes to stderr, stdout stays the tool's.
+ *
+ * PowerConnect_WaitCancellable also gives up once its cancel check says
+ * so; PowerConnect_SignalPending is a ready made check for tools that
+ * block their termination signals and must still stop on them while
+ * PowerManager is down.
+ */
+#ifndef _POWER_CONNECT_H_
+#define _POWER_CONNECT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returned by PowerConnect_WaitCancellable when the cancel check stopped it */
+#define POWER_CONNECT_CANCELLED 0x10000
+
+/* How often PowerConnect_WaitCancellable runs the cancel check while waiting */
+#define POWER_CONNECT_CANCEL_CHECK_MS 100
+
+typedef bool (*PowerConnect_Cancel_t)(void* userdata);
+
+typedef struct _PowerConnect_Stats_t {
+    uint64_t elapsedUs;         /*!< Time from the call until operational */
+    uint32_t attempts;          /*!< PowerController_Connect calls */
+    uint32_t notifications;     /*!< Operational state notifications received */
+    uint32_t lastStatus;        /*!< Status of the last PowerController_Connect */
+} PowerConnect_Stats_t;
+
+/* Call after PowerController_Init. Waits until PowerController is
+   operational, or timeoutMs (0: no timeout) has passed. Returns
+   POWER_CONTROLLER_ERROR_NONE once operational */
+uint32_t PowerConnect_Wait(uint32_t timeoutMs, PowerConnect_Stats_t* stats);
+
+/* Same, but returns POWER_CONNECT_CANCELLED as soon as cancel(userdata)
+   returns true. cancel is called before every connect attempt and at
+   least every POWER_CONNECT_CANCEL_CHECK_MS while waiting */
+uint32_t PowerConnect_WaitCancellable(uint32_t timeoutMs, PowerConnect_Stats_t* stats,
+                                      PowerConnect_Cancel_t cancel, void* userdata);
+
+/* Cancel check: signals is a sigset_t* of blocked signals, true once one
+   of them is pending. The signal stays pending for sigwait or a signalfd */
+bool PowerConnect_SignalPending(void* signals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_CONNECT_H_ */
@@ -0,0 +1,184 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lightsleepSummary.h"
+
+static int summaryFd = -1;
+
+/* Local days since the epoch */
+static uint32_t today(void)
+{
+    time_t now = time(NULL);
+    struct tm tm_info;
+
+    if (localtime_r(&now, &tm_info) == NULL) {
+        return (uint32_t)(now / 86400);
+    }
+    return (uint32_t)((now + tm_info.tm_gmtoff) / 86400);
+}
+
+static off_t recordOffset(uint32_t day)
+{
+    return (off_t)(sizeof(LightsleepSummary_Header_t) +
+                   ((day % LIGHTSLEEP_SUMMARY_DAYS) * sizeof(LightsleepSummary_Day_t)));
+}
+
+/* Read today's record, starting a fresh one if its slot holds an older day */
+static int loadToday(LightsleepSummary_Day_t* record)
+{
+    uint32_t day = today();
+
+    if (summaryFd < 0) {
+        return -1;
+    }
+    if ((pread(summaryFd, record, sizeof(*record), recordOffset(day)) != (ssize_t)sizeof(*record)) ||
+        (record->day != day)) {
+        memset(record, 0, sizeof(*record));
+        record->day = day;
+    }
+    return 0;
+}
+
+static void storeToday(const LightsleepSummary_Day_t* record)
+{
+    if (pwrite(summaryFd, record, sizeof(*record), recordOffset(record->day)) != (ssize_t)sizeof(*record)) {
+        printf("LightsleepSummary: write failed (%s)\n", strerror(errno));
+    }
+}
+
+int LightsleepSummary_Open(const char* path)
+{
+    LightsleepSummary_Header_t header;
+
+    summaryFd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (summaryFd < 0) {
+        printf("LightsleepSummary_Open: Not able to open %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    if ((pread(summaryFd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) ||
+        (header.magic != LIGHTSLEEP_SUMMARY_MAGIC) || (header.version != LIGHTSLEEP_SUMMARY_VERSION) ||
+        (header.days != LIGHTSLEEP_SUMMARY_DAYS) || (header.recordSize != sizeof(LightsleepSummary_Day_t))) {
+        /* New or incompatible file, start over */
+        header.magic = LIGHTSLEEP_SUMMARY_MAGIC;
+        header.version = LIGHTSLEEP_SUMMARY_VERSION;
+        header.days = LIGHTSLEEP_SUMMARY_DAYS;
+        header.recordSize = sizeof(LightsleepSummary_Day_t);
+        if ((ftruncate(summaryFd, 0) != 0) ||
+            (ftruncate(summaryFd, recordOffset(LIGHTSLEEP_SUMMARY_DAYS - 1) + (off_t)sizeof(LightsleepSummary_Day_t)) != 0) ||
+            (pwrite(summaryFd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))) {
+            printf("LightsleepSummary_Open: Not able to initialize %s (%s)\n", path, strerror(errno));
+            close(summaryFd);
+            summaryFd = -1;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void LightsleepSummary_Begin(void)
+{
+    LightsleepSummary_Day_t record;
+
+    if (loadToday(&record) == 0) {
+        record.standbyCount++;
+        storeToday(&record);
+    }
+}
+
+void LightsleepSummary_End(uint64_t durationSec, uint64_t idleWakeups)
+{
+    LightsleepSummary_Day_t record;
+
+    if (loadToday(&record) == 0) {
+        record.wakeCount++;
+        record.standbySec += durationSec;
+        record.idleWakeups += idleWakeups;
+        if (durationSec > record.longestStandbySec) {
+            record.longestStandbySec = (uint32_t)durationSec;
+        }
+        storeToday(&record);
+    }
+}
+
+int LightsleepSummary_Print(const char* path)
+{
+    LightsleepSummary_Header_t header;
+    LightsleepSummary_Day_t records[LIGHTSLEEP_SUMMARY_DAYS];
+    int fd = open(path, O_RDONLY);
+    int count = 0;
+
+    if (fd < 0) {
+        printf("Not able to open %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    if ((read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) ||
+        (header.magic != LIGHTSLEEP_SUMMARY_MAGIC) || (header.version != LIGHTSLEEP_SUMMARY_VERSION) ||
+        (header.days != LIGHTSLEEP_SUMMARY_DAYS) || (header.recordSize != sizeof(LightsleepSummary_Day_t)) ||
+        (read(fd, records, sizeof(records)) != (ssize_t)sizeof(records))) {
+        printf("%s is not a lightsleep summary\n", path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    /* Oldest first: the ring slot after the newest day holds the oldest one */
+    uint32_t newest = 0;
+    for (int i = 0; i < LIGHTSLEEP_SUMMARY_DAYS; i++) {
+        if (records[i].day > newest) {
+            newest = records[i].day;
+        }
+    }
+
+    printf("%-10s %8s %8s %12s %12s %12s\n", "date", "standby", "wakes", "standby_sec", "longest_sec", "idle_wakeups");
+    for (uint32_t day = newest - (LIGHTSLEEP_SUMMARY_DAYS - 1); day <= newest; day++) {
+        const LightsleepSummary_Day_t* record = &records[day % LIGHTSLEEP_SUMMARY_DAYS];
+        time_t midnight = (time_t)day * 86400;
+        struct tm tm_info;
+        char date[16];
+
+        if ((record->day == 0) || (record->day != day)) {
+            continue;
+        }
+        gmtime_r(&midnight, &tm_info);
+        strftime(date, sizeof(date), "%Y-%m-%d", &tm_info);
+        printf("%-10s %8u %8u %12llu %12u %12llu\n", date, record->standbyCount, record->wakeCount,
+               (unsigned long long)record->standbySec, record->longestStandbySec,
+               (unsigned long long)record->idleWakeups);
+        count++;
+    }
+    if (count == 0) {
+        printf("(no standby recorded)\n");
+    }
+    return 0;
+}
+
+void LightsleepSummary_Close(void)
+{
+    if (summaryFd >= 0) {
+        close(summaryFd);
+        summaryFd = -1;
+    }
+}
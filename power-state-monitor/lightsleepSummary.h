@@ -0,0 +1,74 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Per day summary of the lightsleep monitoring.
+ *
+ * lightsleep.log is rotated away once it reaches its size cap; the
+ * counts and durations it held are kept here instead, one fixed size
+ * record per local day in a small ring file.
+ */
+#ifndef _LIGHTSLEEP_SUMMARY_H_
+#define _LIGHTSLEEP_SUMMARY_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LIGHTSLEEP_SUMMARY_FILE "/tmp/lightsleep_summary.bin"
+#define LIGHTSLEEP_SUMMARY_MAGIC 0x4d55534c /* "LSUM" */
+#define LIGHTSLEEP_SUMMARY_VERSION 1
+#define LIGHTSLEEP_SUMMARY_DAYS 31
+
+typedef struct _LightsleepSummary_Header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t days;              /*!< Records in the ring */
+    uint32_t recordSize;
+} LightsleepSummary_Header_t;
+
+typedef struct _LightsleepSummary_Day_t {
+    uint32_t day;               /*!< Local days since the epoch, 0 for an unused record */
+    uint32_t standbyCount;      /*!< Standby periods started this day */
+    uint32_t wakeCount;         /*!< Standby periods that ended with power ON this day */
+    uint32_t longestStandbySec;
+    uint64_t standbySec;        /*!< Total length of the periods that ended this day */
+    uint64_t idleWakeups;       /*!< Monitor wakeups while in standby */
+} LightsleepSummary_Day_t;
+
+/* Open (creating if needed) the summary file. Returns 0 on success */
+int LightsleepSummary_Open(const char* path);
+
+/* A standby period started */
+void LightsleepSummary_Begin(void);
+
+/* A standby period of durationSec ended with power ON */
+void LightsleepSummary_End(uint64_t durationSec, uint64_t idleWakeups);
+
+/* Print the recorded days, oldest first. Returns 0 on success */
+int LightsleepSummary_Print(const char* path);
+
+void LightsleepSummary_Close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIGHTSLEEP_SUMMARY_H_ */
@@ -0,0 +1,338 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "monitorLoop.h"
+
+#define MAX_WATCHES 16
+#define MAX_EVENTS 8
+#define POST_QUEUE_SIZE 32
+#define MAX_TIMERS 8
+
+typedef struct {
+    int fd;
+    MonitorLoop_FdHandler_t handler;
+    void* userdata;
+} Watch;
+
+typedef struct {
+    MonitorLoop_PostHandler_t handler;
+    size_t len;
+    unsigned char data[MONITOR_LOOP_POST_MAX];
+} PostItem;
+
+typedef struct {
+    bool used;
+    uint32_t periodMs;          /* 0 while stopped */
+    uint64_t deadlineMs;        /* CLOCK_MONOTONIC */
+    MonitorLoop_TimerHandler_t handler;
+    void* userdata;
+} Timer;
+
+static int epollFd = -1;
+static int postFd = -1;
+static int timerFd = -1;
+static Timer timers[MAX_TIMERS];
+static uint32_t timerSlackMs = 0;
+static bool running = false;
+static uint64_t wakeups = 0;
+static Watch watches[MAX_WATCHES];
+
+static pthread_mutex_t postLock = PTHREAD_MUTEX_INITIALIZER;
+static PostItem postQueue[POST_QUEUE_SIZE];
+static unsigned int postHead = 0;
+static unsigned int postCount = 0;
+
+static void dispatchPosted(int fd, uint32_t events, void* userdata)
+{
+    uint64_t count = 0;
+    PostItem item;
+
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        return;
+    }
+
+    /* Run handlers without the lock, they may post again */
+    while (1) {
+        pthread_mutex_lock(&postLock);
+        if (postCount == 0) {
+            pthread_mutex_unlock(&postLock);
+            break;
+        }
+        item = postQueue[postHead];
+        postHead = (postHead + 1) % POST_QUEUE_SIZE;
+        postCount--;
+        pthread_mutex_unlock(&postLock);
+
+        item.handler(item.data, item.len);
+    }
+}
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000ULL) + ((uint64_t)ts.tv_nsec / 1000000ULL);
+}
+
+/* Arm the timerfd for the earliest running timer, or disarm it */
+static void armTimers(void)
+{
+    struct itimerspec spec;
+    uint64_t earliest = 0;
+
+    if (timerFd < 0) {
+        return;
+    }
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        if (timers[i].used && (timers[i].periodMs > 0) &&
+            ((earliest == 0) || (timers[i].deadlineMs < earliest))) {
+            earliest = timers[i].deadlineMs;
+        }
+    }
+
+    memset(&spec, 0, sizeof(spec));
+    if (earliest > 0) {
+        spec.it_value.tv_sec = (time_t)(earliest / 1000);
+        spec.it_value.tv_nsec = (long)(earliest % 1000) * 1000000L;
+    }
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, NULL) != 0) {
+        printf("MonitorLoop: timerfd_settime failed (%s)\n", strerror(errno));
+    }
+}
+
+static void dispatchTimers(int fd, uint32_t events, void* userdata)
+{
+    uint64_t expirations = 0;
+    uint64_t now;
+
+    /* EAGAIN when the timer was re-armed after it fired */
+    if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return;
+    }
+
+    now = monotonic_ms();
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        Timer* timer = &timers[i];
+        if (!timer->used || (timer->periodMs == 0) || (timer->deadlineMs > now + timerSlackMs)) {
+            continue;
+        }
+        /* Skip missed periods instead of firing them in a burst */
+        do {
+            timer->deadlineMs += timer->periodMs;
+        } while (timer->deadlineMs <= now);
+        timer->handler(timer->userdata);
+    }
+    armTimers();
+}
+
+int MonitorLoop_Init(void)
+{
+    for (int i = 0; i < MAX_WATCHES; i++) {
+        watches[i].fd = -1;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        printf("MonitorLoop_Init: epoll_create1 failed (%s)\n", strerror(errno));
+        return -1;
+    }
+    postFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (postFd < 0) {
+        printf("MonitorLoop_Init: eventfd failed (%s)\n", strerror(errno));
+        close(epollFd);
+        epollFd = -1;
+        return -1;
+    }
+    if (MonitorLoop_AddFd(postFd, EPOLLIN, dispatchPosted, NULL) != 0) {
+        return -1;
+    }
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timerFd < 0) {
+        printf("MonitorLoop_Init: timerfd_create failed (%s)\n", strerror(errno));
+        return -1;
+    }
+    return MonitorLoop_AddFd(timerFd, EPOLLIN, dispatchTimers, NULL);
+}
+
+int MonitorLoop_AddFd(int fd, uint32_t events, MonitorLoop_FdHandler_t handler, void* userdata)
+{
+    struct epoll_event ev;
+
+    for (int i = 0; i < MAX_WATCHES; i++) {
+        if (watches[i].fd < 0) {
+            memset(&ev, 0, sizeof(ev));
+            ev.events = events;
+            ev.data.u32 = (uint32_t)i;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                printf("MonitorLoop_AddFd: epoll_ctl failed for fd %d (%s)\n", fd, strerror(errno));
+                return -1;
+            }
+            watches[i].fd = fd;
+            watches[i].handler = handler;
+            watches[i].userdata = userdata;
+            return 0;
+        }
+    }
+    printf("MonitorLoop_AddFd: no free watch slot for fd %d\n", fd);
+    return -1;
+}
+
+void MonitorLoop_RemoveFd(int fd)
+{
+    for (int i = 0; i < MAX_WATCHES; i++) {
+        if (watches[i].fd == fd) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL);
+            watches[i].fd = -1;
+            watches[i].handler = NULL;
+            return;
+        }
+    }
+}
+
+int MonitorLoop_AddTimer(uint32_t periodMs, MonitorLoop_TimerHandler_t handler, void* userdata)
+{
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        if (!timers[i].used) {
+            timers[i].used = true;
+            timers[i].handler = handler;
+            timers[i].userdata = userdata;
+            MonitorLoop_SetTimer(i, periodMs);
+            return i;
+        }
+    }
+    printf("MonitorLoop_AddTimer: no free timer slot\n");
+    return -1;
+}
+
+void MonitorLoop_SetTimer(int id, uint32_t periodMs)
+{
+    if ((id < 0) || (id >= MAX_TIMERS) || !timers[id].used) {
+        return;
+    }
+    timers[id].periodMs = periodMs;
+    timers[id].deadlineMs = monotonic_ms() + periodMs;
+    armTimers();
+}
+
+void MonitorLoop_RemoveTimer(int id)
+{
+    if ((id < 0) || (id >= MAX_TIMERS)) {
+        return;
+    }
+    memset(&timers[id], 0, sizeof(timers[id]));
+    armTimers();
+}
+
+void MonitorLoop_SetTimerSlack(uint32_t slackMs)
+{
+    timerSlackMs = slackMs;
+}
+
+int MonitorLoop_Post(MonitorLoop_PostHandler_t handler, const void* data, size_t len)
+{
+    uint64_t one = 1;
+
+    if ((len > MONITOR_LOOP_POST_MAX) || (postFd < 0)) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&postLock);
+    if (postCount == POST_QUEUE_SIZE) {
+        pthread_mutex_unlock(&postLock);
+        printf("MonitorLoop_Post: queue full, event dropped\n");
+        return -1;
+    }
+    PostItem* item = &postQueue[(postHead + postCount) % POST_QUEUE_SIZE];
+    item->handler = handler;
+    item->len = len;
+    if (len > 0) {
+        memcpy(item->data, data, len);
+    }
+    postCount++;
+    pthread_mutex_unlock(&postLock);
+
+    if (write(postFd, &one, sizeof(one)) != sizeof(one)) {
+        printf("MonitorLoop_Post: wakeup failed (%s)\n", strerror(errno));
+    }
+    return 0;
+}
+
+void MonitorLoop_Run(void)
+{
+    struct epoll_event events[MAX_EVENTS];
+
+    running = true;
+    while (running) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno != EINTR) {
+                printf("MonitorLoop_Run: epoll_wait failed (%s)\n", strerror(errno));
+                break;
+            }
+            continue;
+        }
+        wakeups++;
+        for (int i = 0; i < count; i++) {
+            Watch* watch = &watches[events[i].data.u32];
+            /* A handler earlier in this batch may have removed it */
+            if ((watch->fd >= 0) && (watch->handler != NULL)) {
+                watch->handler(watch->fd, events[i].events, watch->userdata);
+            }
+        }
+    }
+}
+
+void MonitorLoop_Quit(void)
+{
+    running = false;
+}
+
+uint64_t MonitorLoop_Wakeups(void)
+{
+    return wakeups;
+}
+
+void MonitorLoop_Term(void)
+{
+    if (timerFd >= 0) {
+        MonitorLoop_RemoveFd(timerFd);
+        close(timerFd);
+        timerFd = -1;
+    }
+    if (postFd >= 0) {
+        MonitorLoop_RemoveFd(postFd);
+        close(postFd);
+        postFd = -1;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+}
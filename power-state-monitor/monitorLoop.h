@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Single threaded epoll event loop of pwr-state-monitor.
+ *
+ * All monitor state is owned by the thread running MonitorLoop_Run.
+ * Other threads (PowerController callbacks) hand work over with
+ * MonitorLoop_Post, which is the only thread safe call.
+ */
+#ifndef _MONITOR_LOOP_H_
+#define _MONITOR_LOOP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest payload MonitorLoop_Post copies */
+#define MONITOR_LOOP_POST_MAX 64
+
+typedef void (*MonitorLoop_FdHandler_t)(int fd, uint32_t events, void* userdata);
+typedef void (*MonitorLoop_PostHandler_t)(const void* data, size_t len);
+typedef void (*MonitorLoop_TimerHandler_t)(void* userdata);
+
+/* Create the loop. Returns 0 on success */
+int MonitorLoop_Init(void);
+
+/* Watch fd for events (EPOLLIN, ...), handler runs on the loop thread. Returns 0 on success */
+int MonitorLoop_AddFd(int fd, uint32_t events, MonitorLoop_FdHandler_t handler, void* userdata);
+
+/* Stop watching fd */
+void MonitorLoop_RemoveFd(int fd);
+
+/* Thread safe: copy data (at most MONITOR_LOOP_POST_MAX bytes) and run handler on the loop thread. Returns 0 on success */
+int MonitorLoop_Post(MonitorLoop_PostHandler_t handler, const void* data, size_t len);
+
+/* Periodic timer every periodMs (0: created stopped). All timers share one
+   timerfd which is disarmed while none is running. Returns the timer id, -1 on error */
+int MonitorLoop_AddTimer(uint32_t periodMs, MonitorLoop_TimerHandler_t handler, void* userdata);
+
+/* Change the period of a timer, 0 stops it. The next expiry is one period from now */
+void MonitorLoop_SetTimer(int id, uint32_t periodMs);
+
+void MonitorLoop_RemoveTimer(int id);
+
+/* Timers due within slackMs of the one that fired run in the same wakeup */
+void MonitorLoop_SetTimerSlack(uint32_t slackMs);
+
+/* Dispatch events until MonitorLoop_Quit */
+void MonitorLoop_Run(void);
+
+/* Make MonitorLoop_Run return after the current dispatch */
+void MonitorLoop_Quit(void);
+
+/* Number of times the loop woke up since start */
+uint64_t MonitorLoop_Wakeups(void);
+
+/* Release the loop */
+void MonitorLoop_Term(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MONITOR_LOOP_H_ */
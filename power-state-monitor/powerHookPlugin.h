@@ -0,0 +1,77 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * pwr-state-monitor hook ABI.
+ *
+ * Plugins are shared objects loaded with dlopen at startup. They export
+ *
+ *     const PowerHook_Plugin_t* PowerHook_GetPlugin(void);
+ *
+ * onEvent runs on the monitor loop thread for every PowerController
+ * notification and must not block; hand slow work to your own thread.
+ *
+ * Pipe and FIFO subscribers receive the same PowerHook_Event_t as a
+ * fixed size binary record per event; eventfd subscribers are only
+ * signalled (counter incremented by one).
+ */
+#ifndef _POWER_HOOK_PLUGIN_H_
+#define _POWER_HOOK_PLUGIN_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POWER_HOOK_ABI_VERSION 1
+#define POWER_HOOK_ENTRY "PowerHook_GetPlugin"
+
+typedef enum _PowerHook_EventType_t {
+    POWER_HOOK_PRE_CHANGE = 1,          /*!< arg1: transactionId, arg2: stateChangeAfter */
+    POWER_HOOK_CHANGED = 2,
+    POWER_HOOK_DEEP_SLEEP_TIMEOUT = 3,  /*!< arg1: wakeupTimeout */
+    POWER_HOOK_REBOOT_BEGIN = 4,
+} PowerHook_EventType_t;
+
+typedef struct _PowerHook_Event_t {
+    uint32_t size;              /*!< sizeof(PowerHook_Event_t) of the monitor, fields are only ever appended */
+    uint32_t type;              /*!< PowerHook_EventType_t */
+    int32_t currentState;       /*!< PowerController_PowerState_t values */
+    int32_t newState;
+    int32_t arg1;
+    int32_t arg2;
+    uint64_t monotonicNs;       /*!< When the notification reached the monitor */
+    uint64_t realtimeNs;
+} PowerHook_Event_t;
+
+typedef struct _PowerHook_Plugin_t {
+    uint32_t abiVersion;        /*!< POWER_HOOK_ABI_VERSION */
+    const char* name;
+    int (*init)(void);          /*!< Optional, non zero refuses the plugin */
+    void (*onEvent)(const PowerHook_Event_t* event);
+    void (*term)(void);         /*!< Optional */
+} PowerHook_Plugin_t;
+
+typedef const PowerHook_Plugin_t* (*PowerHook_GetPlugin_t)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_HOOK_PLUGIN_H_ */
@@ -0,0 +1,228 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "powerHooks.h"
+
+#define MAX_PLUGINS 8
+#define MAX_SUBSCRIBERS 8
+
+typedef struct {
+    void* handle;
+    const PowerHook_Plugin_t* plugin;
+} Plugin_t;
+
+typedef struct {
+    int fd;
+    int isEventFd;
+    int ownFd;              /* Opened here, closed on term */
+    unsigned long dropped;  /* Records lost to a full pipe */
+    char name[64];
+} Subscriber_t;
+
+static Plugin_t plugins[MAX_PLUGINS];
+static int pluginCount = 0;
+static Subscriber_t subscribers[MAX_SUBSCRIBERS];
+static int subscriberCount = 0;
+
+/* The reader of a pipe or FIFO went away for good, stop writing to it */
+static void removeSubscriber(int index)
+{
+    printf("PowerHooks: %s has no reader any more, removed\n", subscribers[index].name);
+    close(subscribers[index].fd);
+    subscriberCount--;
+    memmove(&subscribers[index], &subscribers[index + 1], (size_t)(subscriberCount - index) * sizeof(subscribers[0]));
+}
+
+int PowerHooks_LoadPlugin(const char* path)
+{
+    void* handle;
+    PowerHook_GetPlugin_t getPlugin;
+    const PowerHook_Plugin_t* plugin;
+
+    if (pluginCount >= MAX_PLUGINS) {
+        printf("PowerHooks_LoadPlugin: Too many plugins, %s not loaded\n", path);
+        return -1;
+    }
+    handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) {
+        printf("PowerHooks_LoadPlugin: %s\n", dlerror());
+        return -1;
+    }
+    getPlugin = (PowerHook_GetPlugin_t)dlsym(handle, POWER_HOOK_ENTRY);
+    plugin = (getPlugin != NULL) ? getPlugin() : NULL;
+    if ((plugin == NULL) || (plugin->abiVersion != POWER_HOOK_ABI_VERSION) || (plugin->onEvent == NULL)) {
+        printf("PowerHooks_LoadPlugin: %s is not a version %d hook plugin\n", path, POWER_HOOK_ABI_VERSION);
+        dlclose(handle);
+        return -1;
+    }
+    if ((plugin->init != NULL) && (plugin->init() != 0)) {
+        printf("PowerHooks_LoadPlugin: %s refused to start\n", path);
+        dlclose(handle);
+        return -1;
+    }
+    plugins[pluginCount].handle = handle;
+    plugins[pluginCount].plugin = plugin;
+    pluginCount++;
+    printf("Loaded hook plugin %s (%s)\n", plugin->name ? plugin->name : "unnamed", path);
+    return 0;
+}
+
+int PowerHooks_LoadDir(const char* dir)
+{
+    DIR* d = opendir(dir);
+    struct dirent* entry;
+    int loaded = 0;
+
+    if (d == NULL) {
+        if (errno != ENOENT) {
+            printf("PowerHooks_LoadDir: Not able to open %s (%s)\n", dir, strerror(errno));
+        }
+        return 0;
+    }
+    while ((entry = readdir(d)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        char path[PATH_MAX];
+
+        if ((len < 4) || (strcmp(entry->d_name + len - 3, ".so") != 0)) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+        if (PowerHooks_LoadPlugin(path) == 0) {
+            loaded++;
+        }
+    }
+    closedir(d);
+    return loaded;
+}
+
+static int addSubscriber(int fd, int isEventFd, int ownFd, const char* name)
+{
+    int flags;
+
+    if (subscriberCount >= MAX_SUBSCRIBERS) {
+        printf("PowerHooks: Too many subscribers, %s not added\n", name);
+        return -1;
+    }
+    /* A stuck reader must never hold up the loop */
+    flags = fcntl(fd, F_GETFL);
+    if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0)) {
+        printf("PowerHooks: %s is not usable (%s)\n", name, strerror(errno));
+        return -1;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    subscribers[subscriberCount].fd = fd;
+    subscribers[subscriberCount].isEventFd = isEventFd;
+    subscribers[subscriberCount].ownFd = ownFd;
+    subscribers[subscriberCount].dropped = 0;
+    snprintf(subscribers[subscriberCount].name, sizeof(subscribers[subscriberCount].name), "%s", name);
+    subscriberCount++;
+    return 0;
+}
+
+int PowerHooks_AddFd(int fd, int isEventFd)
+{
+    char name[32];
+
+    snprintf(name, sizeof(name), "%s %d", isEventFd ? "eventfd" : "fd", fd);
+    return addSubscriber(fd, isEventFd, 0, name);
+}
+
+int PowerHooks_AddFifo(const char* path)
+{
+    int fd;
+
+    if ((mkfifo(path, 0600) != 0) && (errno != EEXIST)) {
+        printf("PowerHooks_AddFifo: Not able to create %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    /* Open for reading too, so the open does not wait for a reader and writes
+       do not fail with EPIPE while there is none */
+    fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        printf("PowerHooks_AddFifo: Not able to open %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    if (addSubscriber(fd, 0, 1, path) != 0) {
+        close(fd);
+        return -1;
+    }
+    return 0;
+}
+
+void PowerHooks_Dispatch(const PowerHook_Event_t* event)
+{
+    static const uint64_t one = 1;
+
+    for (int i = 0; i < pluginCount; i++) {
+        plugins[i].plugin->onEvent(event);
+    }
+
+    for (int i = 0; i < subscriberCount; ) {
+        Subscriber_t* sub = &subscribers[i];
+        const void* data = sub->isEventFd ? (const void*)&one : (const void*)event;
+        size_t len = sub->isEventFd ? sizeof(one) : sizeof(*event);
+        ssize_t written;
+
+        /* Records are smaller than PIPE_BUF, so they are written whole or not at all */
+        do {
+            written = write(sub->fd, data, len);
+        } while ((written < 0) && (errno == EINTR));
+
+        if ((written < 0) && (errno == EPIPE)) {
+            /* Removal moves the next subscriber into slot i */
+            removeSubscriber(i);
+            continue;
+        }
+        if ((written < 0) && (errno == EAGAIN)) {
+            if ((sub->dropped++ % 100) == 0) {
+                printf("PowerHooks: %s is not reading, %lu events dropped\n", sub->name, sub->dropped);
+            }
+        } else if (written != (ssize_t)len) {
+            printf("PowerHooks: Write to %s failed (%s)\n", sub->name, strerror(errno));
+        }
+        i++;
+    }
+}
+
+void PowerHooks_Term(void)
+{
+    while (pluginCount > 0) {
+        Plugin_t* p = &plugins[--pluginCount];
+        if (p->plugin->term != NULL) {
+            p->plugin->term();
+        }
+        dlclose(p->handle);
+    }
+    while (subscriberCount > 0) {
+        Subscriber_t* sub = &subscribers[--subscriberCount];
+        if (sub->ownFd) {
+            close(sub->fd);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Power transition hooks of pwr-state-monitor: in-process plugins (see
+ * powerHookPlugin.h) and pipe, FIFO or eventfd subscribers. Loop thread only.
+ */
+#ifndef _POWER_HOOKS_H_
+#define _POWER_HOOKS_H_
+
+#include "powerHookPlugin.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POWER_HOOKS_DIR "/usr/lib/pwr-state-monitor/hooks"
+
+/* Load one plugin. Returns 0 on success */
+int PowerHooks_LoadPlugin(const char* path);
+
+/* Load every *.so in dir, a missing dir is not an error. Returns the number loaded */
+int PowerHooks_LoadDir(const char* dir);
+
+/* Send event records to an inherited pipe, or signal an inherited eventfd. Returns 0 on success */
+int PowerHooks_AddFd(int fd, int isEventFd);
+
+/* Send event records to a FIFO, created if missing. Returns 0 on success */
+int PowerHooks_AddFifo(const char* path);
+
+void PowerHooks_Dispatch(const PowerHook_Event_t* event);
+
+void PowerHooks_Term(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_HOOKS_H_ */
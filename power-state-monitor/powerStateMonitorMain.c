@@ -21,25 +21,88 @@
 #include <stdlib.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/prctl.h>
+#include <sys/signalfd.h>
 #include <errno.h>      /* Errors */
+#include <getopt.h>
 #include <pthread.h>    /* POSIX Threads */
+#include <signal.h>
 #include <string.h>     /* String handling */
-#include <glib.h>
 #include <time.h>
 #include <unistd.h>
 
 #include "power_controller.h"
+#include "monitorLoop.h"
+#include "powerConnect.h"
+#include "lightsleepSummary.h"
+#include "powerHooks.h"
+#include "powerStateShm.h"
+#include "powerTimeline.h"
+#include "thermalSampler.h"
+#include "thermalSeries.h"
 
 #define TMP_LIGHTSLEEP_ON "/tmp/.lightsleep_on"
 #define TMP_POWER_ON "/tmp/.power_on"
+#define TMP_STANDBY "/tmp/.standby"
+#define TMP_POWER_STATE "/tmp/.power_state"
 #define LOG_FILE_NAME "/lightsleep.log"
+#define LOG_BUFFER_SIZE 4096
+#define LOG_DEFAULT_MAX_SIZE (64 * 1024)
+#define THERMAL_DEFAULT_INTERVAL 60 /* seconds */
+#define STANDBY_DEFAULT_SLACK 1000 /* ms */
+#define MAX_HOOK_ARGS 16
+
+/* PowerController notification as handed from its thread to the loop */
+typedef struct {
+    PowerTimeline_EventType_t type;
+    PowerController_PowerState_t currentState;
+    PowerController_PowerState_t newState;
+    int32_t arg1;
+    int32_t arg2;
+    long long receivedNs;
+    long long receivedRealNs;
+} PowerEvent_t;
+
+/* --hook and --notify-* options, applied once the loop is up */
+typedef struct {
+    int opt;
+    const char* arg;
+} HookArg_t;
 
 static PowerController_PowerState_t gpowerState = POWER_STATE_ON;
 
+/* Lightsleep monitoring, owned by the loop thread */
+static int lightsleepMonitoring = 0;
+static uint64_t lightsleepWakeups = 0;
+static long long powerOnReceivedNs = 0;
+static long long lightsleepStartNs = 0;
+
+/* Low wakeup profile while in standby, owned by the loop thread */
+static uint32_t standbySlackMs = STANDBY_DEFAULT_SLACK;
+static uint32_t standbyThermalInterval = 0;
+static uint32_t thermalInterval = THERMAL_DEFAULT_INTERVAL;
+static int lowWakeupActive = 0;
+static int lightSleepAccounting = 0;
+static long long lightSleepEnteredNs = 0;
+static uint64_t lightSleepEnteredWakeups = 0;
+static long long lightSleepTotalNs = 0;
+static uint64_t lightSleepTotalWakeups = 0;
+
+/* lightsleep.log, kept open and written once per dispatch. Once it
+   would grow past logMaxSize it is renamed to lightsleep.log.1 (the
+   previous .1 is dropped), so it takes at most twice that on tmpfs */
+static int logFd = -1;
+static size_t logMaxSize = LOG_DEFAULT_MAX_SIZE;
+static size_t logSize = 0;
+static char logBuffer[LOG_BUFFER_SIZE];
+static size_t logLength = 0;
+static time_t logStampSecond = (time_t)-1;
+static char logStamp[32] = "";
+
 /* Function Declarations */
 static void _lightsleepEventHandler (const PowerController_PowerState_t currentState,
                                       const PowerController_PowerState_t newState, void* userdata);
-static void* lightsleep_monitor(void *arg);
 
 // Helper to check if file exists
 static int file_exists(const char *filename) {
@@ -47,122 +110,438 @@ static int file_exists(const char *filename) {
     return (stat(filename, &buffer) == 0);
 }
 
-// Helper to get timestamp string
-static void get_timestamp(char *buf, size_t buflen) {
+// Helper to get monotonic time in ns
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((long long)ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+// Helper to get wall clock time in ns
+static long long now_real_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((long long)ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+// Helper to get timestamp string, only formatted again when the second changes
+static const char* get_timestamp(void) {
     time_t now = time(NULL);
     struct tm tm_info;
-    if (localtime_r(&now, &tm_info) == NULL) {
-        if (buflen > 0) {
-            buf[0] = '\0';
+
+    if (now != logStampSecond) {
+        logStampSecond = now;
+        if (localtime_r(&now, &tm_info) == NULL) {
+            logStamp[0] = '\0';
+        } else {
+            strftime(logStamp, sizeof(logStamp), "%Y-%m-%d %H:%M:%S", &tm_info);
         }
-        return;
     }
-     strftime(buf, buflen, "%Y-%m-%d %H:%M:%S", &tm_info);
+    return logStamp;
 }
 
-static void* lightsleep_monitor(void *arg) {
-
-    FILE *log = NULL;
+static int lightsleep_log_open(void) {
+    char log_file[512];
+    struct stat st;
 
-    if (file_exists(TMP_LIGHTSLEEP_ON)) {
-        return NULL;
+    snprintf(log_file, sizeof(log_file), "%s%s", "/tmp", LOG_FILE_NAME);
+    logFd = open(log_file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (logFd < 0) {
+        return -1;
     }
+    logSize = (fstat(logFd, &st) == 0) ? (size_t)st.st_size : 0;
+    return 0;
+}
 
+static void lightsleep_log_rotate(void) {
     char log_file[512];
+    char old_file[520];
+
     snprintf(log_file, sizeof(log_file), "%s%s", "/tmp", LOG_FILE_NAME);
+    snprintf(old_file, sizeof(old_file), "%s.1", log_file);
+    if (rename(log_file, old_file) != 0) {
+        printf("lightsleep_log_rotate: rename failed (%s)\n", strerror(errno));
+    }
+    close(logFd);
+    lightsleep_log_open();
+}
+
+static void lightsleep_log_flush(void) {
+    size_t done = 0;
+
+    if ((logFd < 0) || (logLength == 0)) {
+        return;
+    }
+    if ((logMaxSize > 0) && (logSize > 0) && (logSize + logLength > logMaxSize)) {
+        lightsleep_log_rotate();
+        if (logFd < 0) {
+            logLength = 0;
+            return;
+        }
+    }
+    while (done < logLength) {
+        ssize_t written = write(logFd, logBuffer + done, logLength - done);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("lightsleep_log_flush: write failed (%s)\n", strerror(errno));
+            break;
+        }
+        done += (size_t)written;
+    }
+    logSize += done;
+    logLength = 0;
+}
+
+static void lightsleep_log(const char *message) {
+    int len;
+
+    if ((logFd < 0) && (lightsleep_log_open() != 0)) {
+        return;
+    }
+
+    len = snprintf(NULL, 0, "%s %s\n", get_timestamp(), message);
+    if ((len > 0) && (logLength + (size_t)len >= sizeof(logBuffer))) {
+        lightsleep_log_flush();
+    }
+    if ((len > 0) && ((size_t)len < sizeof(logBuffer))) {
+        logLength += (size_t)snprintf(logBuffer + logLength, sizeof(logBuffer) - logLength,
+                                      "%s %s\n", logStamp, message);
+    }
+}
+
+static void lightsleep_log_close(void) {
+    lightsleep_log_flush();
+    if (logFd >= 0) {
+        close(logFd);
+        logFd = -1;
+    }
+}
+
+// Helper to create an empty file
+static int touch_file(const char *filename) {
+    int fd = open(filename, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+/* Loop wakeups strictly between the one that recorded started and the
+   current one. Both ends can be the same wakeup: every queued
+   notification is handled in one dispatch */
+static uint64_t idle_wakeups_since(uint64_t started) {
+    uint64_t current = MonitorLoop_Wakeups();
+
+    return (current > started) ? (current - started - 1) : 0;
+}
+
+/*****************************************************************
+ * Function Name: lightsleep_begin
+ * Description: On entering standby, start waiting for power ON.
+ *   Nothing polls: lightsleep_end is called from setModeSettings
+ *   as soon as the box is back ON, and the loop does not wake up
+ *   in between. lightsleepMonitoring is the only guard; a marker
+ *   file found here was left by a monitor that did not shut down
+ *   and must not keep this one from monitoring.
+ *****************************************************************/
+static void lightsleep_begin(void) {
+    if (lightsleepMonitoring) {
+        return;
+    }
 
     // Touch /tmp/.lightsleep_on
-    FILE *touch = fopen(TMP_LIGHTSLEEP_ON, "w");
-    if (touch) fclose(touch);
- 
+    touch_file(TMP_LIGHTSLEEP_ON);
+
     if (file_exists(TMP_POWER_ON)) {
-            log = fopen(log_file, "a");
-            if (log) {
-                char ts[32];
-                get_timestamp(ts, sizeof(ts));
-                fprintf(log, "%s Box is in Power ON mode, journalctl will sync the logs..!\n", ts);
-                fclose(log);
-            }
+            lightsleep_log("Box is in Power ON mode, journalctl will sync the logs..!");
             if(remove(TMP_LIGHTSLEEP_ON) != 0) {
                 printf("Error deleting lightsleep file\n");
             }
-            return NULL;
-    }
-
-    log = fopen(log_file, "a");
-    if (log) {
-        char ts[32];
-        get_timestamp(ts, sizeof(ts));
-        fprintf(log, "%s Starting the lightsleep monitoring..!\n", ts);
-        fclose(log);
-    }
-
-    while (1) {
-        sleep(60);
-        if (file_exists(TMP_POWER_ON)) {
-                log = fopen(log_file, "a");
-                if (log) {
-                    char ts[32];
-                    get_timestamp(ts, sizeof(ts));
-                    fprintf(log, "%s Box is in Power ON mode from STANDBY..! exiting\n", ts);
-                    fclose(log);
-                }
-                if(remove(TMP_LIGHTSLEEP_ON) != 0) {
-                    printf("Error deleting lightsleep file\n");
-                }
-                return NULL;
-        }
+            return;
     }
-    return NULL;
+
+    lightsleep_log("Starting the lightsleep monitoring..!");
+    lightsleepMonitoring = 1;
+    lightsleepWakeups = MonitorLoop_Wakeups();
+    lightsleepStartNs = now_ns();
+    LightsleepSummary_Begin();
+}
+
+static void lightsleep_end(void) {
+    char message[160];
+    uint64_t idleWakeups;
+
+    if (!lightsleepMonitoring || !file_exists(TMP_POWER_ON)) {
+        return;
+    }
+
+    idleWakeups = idle_wakeups_since(lightsleepWakeups);
+    snprintf(message, sizeof(message),
+             "Box is in Power ON mode from STANDBY..! exiting (reaction %lld us, %llu idle wakeups in standby)",
+             (now_ns() - powerOnReceivedNs) / 1000, (unsigned long long)idleWakeups);
+    lightsleep_log(message);
+    LightsleepSummary_End((powerOnReceivedNs > lightsleepStartNs) ?
+                          (uint64_t)((powerOnReceivedNs - lightsleepStartNs) / 1000000000LL) : 0, idleWakeups);
+    if(remove(TMP_LIGHTSLEEP_ON) != 0) {
+        printf("Error deleting lightsleep file\n");
+    }
+    lightsleepMonitoring = 0;
+}
+
+/* Shutting down in standby: nobody monitors any more, say so */
+static void lightsleep_stop(void) {
+    if (!lightsleepMonitoring) {
+        return;
+    }
+    lightsleep_log("Monitor stopped in STANDBY, lightsleep monitoring ends..!");
+    if (remove(TMP_LIGHTSLEEP_ON) != 0) {
+        printf("Error deleting lightsleep file\n");
+    }
+    lightsleepMonitoring = 0;
+}
+
+static const char* power_state_name(PowerController_PowerState_t state)
+{
+    switch (state) {
+    case POWER_STATE_OFF: return "OFF";
+    case POWER_STATE_STANDBY: return "STANDBY";
+    case POWER_STATE_ON: return "ON";
+    case POWER_STATE_STANDBY_LIGHT_SLEEP: return "LIGHT_SLEEP";
+    case POWER_STATE_STANDBY_DEEP_SLEEP: return "DEEP_SLEEP";
+    default: return "UNKNOWN";
+    }
+}
+
+/*****************************************************************
+ * Function Name: write_power_state
+ * Description: Replace /tmp/.power_state in one step: readers see
+ *   either the old or the new content, never a partial file.
+ *****************************************************************/
+static int write_power_state(int mode)
+{
+    char content[64];
+    int fd, len;
+
+    len = snprintf(content, sizeof(content), "mode=%s\nstate=%s\n",
+                   mode ? "ON" : "STANDBY", power_state_name(gpowerState));
+
+    fd = open(TMP_POWER_STATE ".tmp", O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        printf("Failure: Not able to create a file (%s.tmp)\n", TMP_POWER_STATE);
+        return -1;
+    }
+    if (write(fd, content, (size_t)len) != len) {
+        printf("Failure: Not able to write a file (%s.tmp)\n", TMP_POWER_STATE);
+        close(fd);
+        unlink(TMP_POWER_STATE ".tmp");
+        return -1;
+    }
+    close(fd);
+    if (rename(TMP_POWER_STATE ".tmp", TMP_POWER_STATE) != 0) {
+        printf("Failure: Not able to update %s (%s)\n", TMP_POWER_STATE, strerror(errno));
+        unlink(TMP_POWER_STATE ".tmp");
+        return -1;
+    }
+    return 0;
 }
 
 /*****************************************************************
  * Input Arguments: int
  * Output Arguments: void
  * Description: This is to set the .standby/poweron flag based on
-                the power MODE
+                the power MODE. /tmp/.power_state is the primary
+                record; the legacy flags are kept for existing
+                readers and are swapped with a single rename() so
+                exactly one of them exists at any time.
 *****************************************************************/
 static void setModeSettings(int mode)
 {
-    int status=0;
-    FILE *fptr = NULL;
-    char setFlag[30] = {0};
-    char deleteFlag[30] = {0};
+    const char *setFlag = NULL;
+    const char *deleteFlag = NULL;
     switch (mode){
        case 1:
-           strcpy(setFlag, "/tmp/.power_on");
-           strcpy(deleteFlag,"/tmp/.standby");
+           setFlag = TMP_POWER_ON;
+           deleteFlag = TMP_STANDBY;
            printf("setModeSettings: Power ON Mode \n");
            break;
        case 0:
-           strcpy(setFlag,"/tmp/.standby");
-           strcpy(deleteFlag,"/tmp/.power_on");
+           setFlag = TMP_STANDBY;
+           deleteFlag = TMP_POWER_ON;
            printf("setModeSettings: STANDBY Mode \n");
-           {
-               pthread_t lightsleep_tid;
-               if (pthread_create(&lightsleep_tid, NULL, lightsleep_monitor, NULL) == 0) {
-                   pthread_detach(lightsleep_tid);
-               } else {
-                   printf("setModeSettings: Failed to create lightsleep_monitor thread\n");
-               }
-           }
            break;
        default:
            printf("setModeSettings: Unknown Argument..!\n");
            return;
     }
-    fptr = fopen(setFlag, "w+");
-    if(fptr == NULL){ //if file does not exist, create it
-         printf("Failure: Not able to create a file (%s)\n",setFlag);
+    write_power_state(mode);
+
+    if (rename(deleteFlag, setFlag) == 0) {
+         printf("Success: File (%s) renamed to (%s)\n", deleteFlag, setFlag);
+    } else if (file_exists(setFlag)) {
+         /* Already in this mode */
+    } else if (touch_file(setFlag) == 0) {
+         printf("Success: File (%s) created successfully..!\n", setFlag);
+    } else {
+         printf("Failure: Not able to create a file (%s)\n", setFlag);
+    }
+    if (mode == 1) {
+        lightsleep_end();
+    } else {
+        lightsleep_begin();
+    }
+}
+
+static int is_standby_state(PowerController_PowerState_t state)
+{
+    return (state == POWER_STATE_STANDBY) || (state == POWER_STATE_STANDBY_LIGHT_SLEEP) ||
+           (state == POWER_STATE_STANDBY_DEEP_SLEEP);
+}
+
+/*****************************************************************
+ * Function Name: apply_power_profile
+ * Description: In standby the monitor has nothing to do but wait for
+ *   the next notification: widen the timer slack of the loop thread,
+ *   let the loop batch timers that are due close together, and slow
+ *   down (by default stop) the periodic thermal sampling so the
+ *   shared timerfd stays disarmed. Also counts the loop wakeups per
+ *   hour of STANDBY_LIGHT_SLEEP to verify it.
+ *****************************************************************/
+static void apply_power_profile(PowerController_PowerState_t state)
+{
+    char message[160];
+    int standby = is_standby_state(state);
+
+    if ((state == POWER_STATE_STANDBY_LIGHT_SLEEP) && !lightSleepAccounting) {
+        lightSleepAccounting = 1;
+        lightSleepEnteredNs = now_ns();
+        lightSleepEnteredWakeups = MonitorLoop_Wakeups();
+    } else if ((state != POWER_STATE_STANDBY_LIGHT_SLEEP) && lightSleepAccounting) {
+        long long spentNs = now_ns() - lightSleepEnteredNs;
+        uint64_t wakeups = idle_wakeups_since(lightSleepEnteredWakeups);
+
+        lightSleepAccounting = 0;
+        lightSleepTotalNs += spentNs;
+        lightSleepTotalWakeups += wakeups;
+        snprintf(message, sizeof(message), "Left LIGHT_SLEEP after %lld s: %llu wakeups (%.2f per hour, %.2f overall)",
+                 spentNs / 1000000000LL, (unsigned long long)wakeups,
+                 (spentNs > 0) ? (wakeups * 3600e9 / spentNs) : 0.0,
+                 (lightSleepTotalNs > 0) ? (lightSleepTotalWakeups * 3600e9 / lightSleepTotalNs) : 0.0);
+        lightsleep_log(message);
     }
-    else{
-         printf("Success: File (%s) created successfully..!\n",setFlag);
-         fclose(fptr);
+
+    if ((standbySlackMs == 0) || (standby == lowWakeupActive)) {
+        return;
     }
-    /* Deletes the standby/poweron file */
-    status = remove(deleteFlag);
-    if(status == 0){
-         printf("Success: File (%s) deleted successfully\n",deleteFlag);
+    lowWakeupActive = standby;
+    if (standby) {
+        prctl(PR_SET_TIMERSLACK, (unsigned long)standbySlackMs * 1000000UL, 0, 0, 0);
+        MonitorLoop_SetTimerSlack(standbySlackMs);
+        ThermalSampler_SetInterval(standbyThermalInterval);
+    } else {
+        /* 0 restores the default slack */
+        prctl(PR_SET_TIMERSLACK, 0, 0, 0, 0);
+        MonitorLoop_SetTimerSlack(0);
+        ThermalSampler_SetInterval(thermalInterval);
+    }
+}
+
+/*****************************************************************
+ * Function Name: handlePowerModeChange
+ * Description: Loop thread side of _lightsleepEventHandler, updates
+ *   the flags for the new power state.
+ *****************************************************************/
+static void handlePowerModeChange(const PowerEvent_t* change)
+{
+	printf("Entering _lightsleepEventHandler:State Changed currentState: %d, newState: %d \n",
+			change->currentState, change->newState);
+	gpowerState = change->newState;
+    PowerStateShm_Publish(change->newState, change->currentState, 1,
+                          (uint64_t)change->receivedNs, (uint64_t)change->receivedRealNs);
+    apply_power_profile(change->newState);
+
+    if(gpowerState == POWER_STATE_ON)
+    {
+         powerOnReceivedNs = change->receivedNs;
+         if ((change->currentState != POWER_STATE_ON) && (change->currentState != POWER_STATE_UNKNOWN)) {
+             ThermalSampler_RecordWakeup();
+         }
+         setModeSettings (1);
+    }
+    else
+    {
+         setModeSettings (0);
+    }
+	printf("Exiting _lightsleepEventHandler..\n");
+}
+
+/* The hook ABI is public and versioned on its own, do not rely on the timeline numbering */
+static uint32_t hookEventType(PowerTimeline_EventType_t type)
+{
+    switch (type) {
+    case POWER_TIMELINE_PRE_CHANGE:
+        return POWER_HOOK_PRE_CHANGE;
+    case POWER_TIMELINE_CHANGED:
+        return POWER_HOOK_CHANGED;
+    case POWER_TIMELINE_DEEP_SLEEP_TIMEOUT:
+        return POWER_HOOK_DEEP_SLEEP_TIMEOUT;
+    case POWER_TIMELINE_REBOOT_BEGIN:
+        return POWER_HOOK_REBOOT_BEGIN;
+    default:
+        return 0;
+    }
+}
+
+/*****************************************************************
+ * Function Name: handlePowerEvent
+ * Description: Runs on the loop thread for every PowerController
+ *   notification: appends it to the timeline, acts on it, then
+ *   passes it to the hook plugins and subscribers.
+ *****************************************************************/
+static void handlePowerEvent(const void* data, size_t len)
+{
+    const PowerEvent_t* event = (const PowerEvent_t*)data;
+    PowerController_PowerState_t from = event->currentState;
+    PowerController_PowerState_t to = event->newState;
+    PowerHook_Event_t hookEvent;
+
+    /* DeepSleepTimeout and RebootBegin carry no state, record the one they happened in */
+    if (from == POWER_STATE_UNKNOWN) {
+        from = gpowerState;
+    }
+    if (to == POWER_STATE_UNKNOWN) {
+        to = gpowerState;
+    }
+    PowerTimeline_Record(event->type, from, to, event->arg1, event->arg2,
+                         (uint64_t)event->receivedNs, (uint64_t)event->receivedRealNs);
+
+    if (event->type == POWER_TIMELINE_CHANGED) {
+        handlePowerModeChange(event);
+    }
+
+    /* Hooks run after the flags and shm are updated, so they see the new state */
+    hookEvent.size = sizeof(hookEvent);
+    hookEvent.type = hookEventType(event->type);
+    hookEvent.currentState = from;
+    hookEvent.newState = to;
+    hookEvent.arg1 = event->arg1;
+    hookEvent.arg2 = event->arg2;
+    hookEvent.monotonicNs = (uint64_t)event->receivedNs;
+    hookEvent.realtimeNs = (uint64_t)event->receivedRealNs;
+    PowerHooks_Dispatch(&hookEvent);
+    lightsleep_log_flush();
+}
+
+/* Runs on the PowerController thread; all state is changed on the loop thread */
+static void postPowerEvent(PowerTimeline_EventType_t type, PowerController_PowerState_t currentState,
+                           PowerController_PowerState_t newState, int32_t arg1, int32_t arg2)
+{
+    PowerEvent_t event = { type, currentState, newState, arg1, arg2, now_ns(), now_real_ns() };
+
+    if (MonitorLoop_Post(handlePowerEvent, &event, sizeof(event)) != 0) {
+        printf("postPowerEvent: Failed to queue event %d (%d -> %d)\n", type, currentState, newState);
     }
 }
 
@@ -182,53 +561,49 @@ static void setModeSettings(int mode)
 static void _lightsleepEventHandler (const PowerController_PowerState_t currentState,
                                       const PowerController_PowerState_t newState, void* userdata)
 {
-	printf("Entering _lightsleepEventHandler:State Changed currentState: %d, newState: %d \n",
-			currentState, newState);
-	gpowerState = newState;
+    postPowerEvent(POWER_TIMELINE_CHANGED, currentState, newState, 0, 0);
+}
 
-    if(gpowerState == POWER_STATE_ON)
-    {
-         setModeSettings (1);
-    }
-    else
-    {
-         setModeSettings (0);
-    }
-	printf("Exiting _lightsleepEventHandler..\n");
+/* Timeline only notifications */
+static void _preChangeEventHandler(const PowerController_PowerState_t currentState,
+                                   const PowerController_PowerState_t newState,
+                                   const int transactionId, const int stateChangeAfter, void* userdata)
+{
+    postPowerEvent(POWER_TIMELINE_PRE_CHANGE, currentState, newState, transactionId, stateChangeAfter);
 }
+
+static void _deepSleepTimeoutEventHandler(const int wakeupTimeout, void* userdata)
+{
+    postPowerEvent(POWER_TIMELINE_DEEP_SLEEP_TIMEOUT, POWER_STATE_UNKNOWN, POWER_STATE_UNKNOWN, wakeupTimeout, 0);
+}
+
+static void _rebootBeginEventHandler(const char* rebootReasonCustom, const char* rebootReasonOther,
+                                     const char* rebootRequestor, void* userdata)
+{
+    printf("Reboot requested by %s (%s, %s)\n", rebootRequestor ? rebootRequestor : "unknown",
+           rebootReasonCustom ? rebootReasonCustom : "", rebootReasonOther ? rebootReasonOther : "");
+    postPowerEvent(POWER_TIMELINE_REBOOT_BEGIN, POWER_STATE_UNKNOWN, POWER_STATE_OFF, 0, 0);
+}
+
 /*****************************************************************
- * Function Name: power_monitor_init
+ * Function Name: sync_power_state
  * Input Parameters: (void)
  * Output Parameters: void
- * Description: Set the power flag during bootup and 
-                Detect the power transitions
+ * Description: Query the current power state and set the flags
+                to match, at bootup and on SIGHUP
 *****************************************************************/
-int power_monitor_init(void)
+static void sync_power_state(void)
 {
     uint32_t res = 0;
     PowerController_PowerState_t curState = POWER_STATE_UNKNOWN, previousState = POWER_STATE_UNKNOWN;
 
-    PowerController_Init();
-
-    while (!PowerController_IsOperational()) {
-        uint32_t status = PowerController_Connect();
-
-        if (POWER_CONTROLLER_ERROR_NONE == status) {
-            printf("\nSuccess :: Connect\n");
-            break;
-        } else if (POWER_CONTROLLER_ERROR_UNAVAILABLE == status) {
-            printf("\nFailed :: Connect :: Thunder is UNAVAILABLE\n");
-        } else if (POWER_CONTROLLER_ERROR_NOT_EXIST == status) {
-            printf("\nFailed :: Connect :: PowerManager is UNAVAILABLE\n");
-        } else {
-            // Do nothing
-        }
-        usleep(100 * 1000); // 100ms
-    }
-
+    powerOnReceivedNs = now_ns();
     res = PowerController_GetPowerState(&curState, &previousState);
 
     if (POWER_CONTROLLER_ERROR_NONE == res) {
+        gpowerState = curState;
+        apply_power_profile(curState);
+        PowerStateShm_Publish(curState, previousState, 0, (uint64_t)now_ns(), (uint64_t)now_real_ns());
         if (POWER_STATE_OFF == curState) {
             printf("OFF Mode\n");
             setModeSettings(0);
@@ -252,37 +627,287 @@ int power_monitor_init(void)
     } else {
         printf("Error :: Unknown\n");
     }
+    lightsleep_log_flush();
+}
+
+/*****************************************************************
+ * Function Name: power_monitor_init
+ * Input Parameters: stopSignals - blocked signals that end the wait
+ * Output Parameters: int
+ * Description: Set the power flag during bootup and 
+                Detect the power transitions. Returns -1 if one of
+                stopSignals arrived before PowerController came up
+*****************************************************************/
+int power_monitor_init(sigset_t* stopSignals)
+{
+    PowerConnect_Stats_t stats;
+    char message[160];
+
+    PowerController_Init();
+
+    /* Sleeps until PowerManager is up instead of polling it. The signals
+       are blocked for the signalfd, so the wait checks for them itself */
+    if (PowerConnect_WaitCancellable(0, &stats, PowerConnect_SignalPending, stopSignals) == POWER_CONNECT_CANCELLED) {
+        lightsleep_log("Stopped while waiting for PowerController");
+        return -1;
+    }
+    snprintf(message, sizeof(message),
+             "PowerController operational after %llu ms (%u connect attempts, %u notifications)",
+             (unsigned long long)(stats.elapsedUs / 1000), stats.attempts, stats.notifications);
+    lightsleep_log(message);
+
+    sync_power_state();
 
     return 0;
 }
+/*****************************************************************
+ * Function Name: handleSignal
+ * Description: signalfd handler. SIGTERM/SIGINT stop the loop for a
+                clean shutdown, SIGHUP re-syncs the power flags.
+*****************************************************************/
+static void handleSignal(int fd, uint32_t events, void* userdata)
+{
+    struct signalfd_siginfo info;
+
+    if (read(fd, &info, sizeof(info)) != sizeof(info)) {
+        return;
+    }
+    if (info.ssi_signo == SIGHUP) {
+        printf("SIGHUP: re-syncing power state flags\n");
+        sync_power_state();
+    } else {
+        printf("Signal %u: shutting down\n", info.ssi_signo);
+        MonitorLoop_Quit();
+    }
+}
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [--timeline FILE] [--timeline-size RECORDS] [--no-timeline]\n"
+           "       [--thermal FILE] [--thermal-interval SEC] [--thermal-blocks BLOCKS] [--no-thermal]\n"
+           "       [--log-max-size BYTES] [--summary FILE] [--no-summary] [--print-summary]\n"
+           "       [--standby-slack MS] [--standby-thermal-interval SEC]\n"
+           "       [--hook-dir DIR] [--hook PLUGIN]... [--notify-fd FD]... [--notify-eventfd FD]... [--notify-fifo PATH]...\n", name);
+    printf("   --timeline FILE          ring file the power transitions are recorded to (default %s)\n", POWER_TIMELINE_FILE);
+    printf("   --timeline-size RECORDS  number of transitions kept (default %d)\n", POWER_TIMELINE_DEFAULT_CAPACITY);
+    printf("   --no-timeline            do not record transitions\n");
+    printf("   --thermal FILE           thermal and wakeup time series (default %s)\n", THERMAL_SERIES_FILE);
+    printf("   --thermal-interval SEC   temperature sample period, 0 for level changes only (default %d)\n", THERMAL_DEFAULT_INTERVAL);
+    printf("   --thermal-blocks BLOCKS  %d byte blocks kept (default %d)\n", THERMAL_SERIES_BLOCK_SIZE, THERMAL_SERIES_DEFAULT_BLOCKS);
+    printf("   --no-thermal             do not record thermal data\n");
+    printf("   --log-max-size BYTES     rotate /tmp%s to .1 at this size, 0 to never rotate (default %d)\n", LOG_FILE_NAME, LOG_DEFAULT_MAX_SIZE);
+    printf("   --summary FILE           per day standby summary (default %s)\n", LIGHTSLEEP_SUMMARY_FILE);
+    printf("   --no-summary             do not keep the standby summary\n");
+    printf("   --print-summary          print the standby summary and exit\n");
+    printf("   --standby-slack MS       timer slack while in standby, 0 disables the low wakeup profile (default %d)\n", STANDBY_DEFAULT_SLACK);
+    printf("   --standby-thermal-interval SEC  temperature sample period in standby, 0 to stop (default 0)\n");
+    printf("   --hook-dir DIR           load every *.so in DIR as a hook plugin, empty for none (default %s)\n", POWER_HOOKS_DIR);
+    printf("   --hook PLUGIN            load one hook plugin\n");
+    printf("   --notify-fd FD           write a binary record per event to an inherited pipe\n");
+    printf("   --notify-eventfd FD      signal an inherited eventfd on every event\n");
+    printf("   --notify-fifo PATH       write a binary record per event to a FIFO, created if missing\n");
+}
+
 /*********************************************************
  * Function Name: main ()
  * Input Parameters: int argc, char *argv[]
  * Output Parameters: int
- * Description: Registers the lightsleep thread functions
+ * Description: Runs the event loop that handles power mode
+                changes and signals until SIGTERM
 *********************************************************/
 int main(int argc, char *argv[])
 {
-    GAsyncQueue *msgQueuePtr=NULL;
-
-    power_monitor_init();
-    
-    /* Register the event callback function..! */
-    printf("%s : Registering Callback for Power Mode Change Notification..!\n", __FUNCTION__);
-    PowerController_RegisterPowerModeChangedCallback(_lightsleepEventHandler, NULL);
-    
-     /* Create the async queue once and keep the process alive by popping from it */
-    msgQueuePtr = g_async_queue_new ();
-    if ( msgQueuePtr == NULL ){
-        printf("Not able to create a queue..!");
+    static struct option options[] = {
+        {"timeline", required_argument, 0, 't'},
+        {"timeline-size", required_argument, 0, 's'},
+        {"no-timeline", no_argument, 0, 'n'},
+        {"thermal", required_argument, 0, 'T'},
+        {"thermal-interval", required_argument, 0, 'I'},
+        {"thermal-blocks", required_argument, 0, 'B'},
+        {"no-thermal", no_argument, 0, 'N'},
+        {"log-max-size", required_argument, 0, 'L'},
+        {"summary", required_argument, 0, 'S'},
+        {"no-summary", no_argument, 0, 'X'},
+        {"print-summary", no_argument, 0, 'P'},
+        {"standby-slack", required_argument, 0, 'K'},
+        {"standby-thermal-interval", required_argument, 0, 'i'},
+        {"hook-dir", required_argument, 0, 'D'},
+        {"hook", required_argument, 0, 'H'},
+        {"notify-fd", required_argument, 0, 'F'},
+        {"notify-eventfd", required_argument, 0, 'E'},
+        {"notify-fifo", required_argument, 0, 'O'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char* timelineFile = POWER_TIMELINE_FILE;
+    uint32_t timelineSize = POWER_TIMELINE_DEFAULT_CAPACITY;
+    const char* thermalFile = THERMAL_SERIES_FILE;
+    uint32_t thermalBlocks = THERMAL_SERIES_DEFAULT_BLOCKS;
+    const char* summaryFile = LIGHTSLEEP_SUMMARY_FILE;
+    int printSummary = 0;
+    const char* hookDir = POWER_HOOKS_DIR;
+    HookArg_t hookArgs[MAX_HOOK_ARGS];
+    int hookArgCount = 0;
+    sigset_t signals, stopSignals;
+    int signalFd = -1;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "t:s:nT:I:B:NL:S:XPK:i:D:H:F:E:O:h", options, NULL)) != -1) {
+        switch (opt) {
+        case 't':
+            timelineFile = optarg;
+            break;
+        case 's':
+            timelineSize = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            timelineFile = NULL;
+            break;
+        case 'T':
+            thermalFile = optarg;
+            break;
+        case 'I':
+            thermalInterval = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'B':
+            thermalBlocks = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'N':
+            thermalFile = NULL;
+            break;
+        case 'L':
+            logMaxSize = (size_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'S':
+            summaryFile = optarg;
+            break;
+        case 'X':
+            summaryFile = NULL;
+            break;
+        case 'P':
+            printSummary = 1;
+            break;
+        case 'K':
+            standbySlackMs = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'i':
+            standbyThermalInterval = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'D':
+            hookDir = optarg;
+            break;
+        case 'H':
+        case 'F':
+        case 'E':
+        case 'O':
+            if (hookArgCount == MAX_HOOK_ARGS) {
+                printf("Too many hooks, %s ignored\n", optarg);
+                break;
+            }
+            hookArgs[hookArgCount].opt = opt;
+            hookArgs[hookArgCount].arg = optarg;
+            hookArgCount++;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (printSummary) {
+        return (LightsleepSummary_Print(summaryFile ? summaryFile : LIGHTSLEEP_SUMMARY_FILE) == 0) ? 0 : 1;
+    }
+
+    /* Block before any thread is created, so only the signalfd sees them */
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    /* A subscriber closing its pipe must not kill the monitor, PowerHooks handles EPIPE */
+    signal(SIGPIPE, SIG_IGN);
+
+    if (MonitorLoop_Init() != 0) {
+        printf("Not able to create the event loop..!\n");
         return 1;
     }
+    signalFd = signalfd(-1, &signals, SFD_CLOEXEC);
+    if ((signalFd < 0) || (MonitorLoop_AddFd(signalFd, EPOLLIN, handleSignal, NULL) != 0)) {
+        printf("Not able to watch signals (%s)..!\n", strerror(errno));
+    }
 
-    /* This call will make the process alive */
-    while (true)
-    {
-        printf("Wait Call for message pop..!\n");
-        g_async_queue_pop (msgQueuePtr);
+    if ((timelineFile != NULL) && (PowerTimeline_Open(timelineFile, timelineSize) != 0)) {
+        printf("Not able to open the timeline %s, transitions are not recorded..!\n", timelineFile);
     }
-}
 
+    if ((summaryFile != NULL) && (LightsleepSummary_Open(summaryFile) != 0)) {
+        printf("Not able to open %s, standby is not summarized..!\n", summaryFile);
+    }
+
+    if (PowerStateShm_Open() != 0) {
+        printf("Not able to publish the power state in shared memory..!\n");
+    }
+
+    if ((hookDir != NULL) && (hookDir[0] != '\0')) {
+        PowerHooks_LoadDir(hookDir);
+    }
+    for (int i = 0; i < hookArgCount; i++) {
+        const char* arg = hookArgs[i].arg;
+        int status;
+
+        if (hookArgs[i].opt == 'H') {
+            status = PowerHooks_LoadPlugin(arg);
+        } else if (hookArgs[i].opt == 'O') {
+            status = PowerHooks_AddFifo(arg);
+        } else {
+            status = PowerHooks_AddFd(atoi(arg), hookArgs[i].opt == 'E');
+        }
+        if (status != 0) {
+            printf("Not able to add the hook %s..!\n", arg);
+        }
+    }
+
+    /* SIGHUP only re-syncs, it does not stop the wait for PowerController */
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGTERM);
+    sigaddset(&stopSignals, SIGINT);
+    if (power_monitor_init(&stopSignals) != 0) {
+        printf("Signal received while waiting for PowerController: shutting down\n");
+    } else {
+        if ((thermalFile != NULL) && (ThermalSampler_Init(thermalFile, thermalBlocks, thermalInterval) != 0)) {
+            printf("Not able to open %s, thermal data is not recorded..!\n", thermalFile);
+        } else if (lowWakeupActive) {
+            /* Booted in standby */
+            ThermalSampler_SetInterval(standbyThermalInterval);
+        }
+
+        /* Register the event callback function..! */
+        printf("%s : Registering Callback for Power Mode Change Notification..!\n", __FUNCTION__);
+        PowerController_RegisterPowerModeChangedCallback(_lightsleepEventHandler, NULL);
+        PowerController_RegisterPowerModePreChangeCallback(_preChangeEventHandler, NULL);
+        PowerController_RegisterDeepSleepTimeoutCallback(_deepSleepTimeoutEventHandler, NULL);
+        PowerController_RegisterRebootBeginCallback(_rebootBeginEventHandler, NULL);
+
+        MonitorLoop_Run();
+
+        PowerController_UnRegisterRebootBeginCallback(_rebootBeginEventHandler);
+        PowerController_UnRegisterDeepSleepTimeoutCallback(_deepSleepTimeoutEventHandler);
+        PowerController_UnRegisterPowerModePreChangeCallback(_preChangeEventHandler);
+        PowerController_UnRegisterPowerModeChangedCallback(_lightsleepEventHandler);
+        ThermalSampler_Term();
+    }
+    PowerController_Term();
+    PowerHooks_Term();
+    PowerTimeline_Close();
+    PowerStateShm_Close();
+    lightsleep_stop();
+    LightsleepSummary_Close();
+    lightsleep_log_close();
+
+    if (signalFd >= 0) {
+        MonitorLoop_RemoveFd(signalFd);
+        close(signalFd);
+    }
+    MonitorLoop_Term();
+    return 0;
+}
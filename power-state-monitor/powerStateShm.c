@@ -0,0 +1,95 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "powerStateShm.h"
+
+static PowerStateShm_t* shm = NULL;
+
+int PowerStateShm_Open(void)
+{
+    int fd = shm_open(POWER_STATE_SHM_NAME, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    if (fd < 0) {
+        printf("PowerStateShm_Open: shm_open failed (%s)\n", strerror(errno));
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(PowerStateShm_t)) != 0) {
+        printf("PowerStateShm_Open: ftruncate failed (%s)\n", strerror(errno));
+        close(fd);
+        return -1;
+    }
+    shm = (PowerStateShm_t*)mmap(NULL, sizeof(PowerStateShm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        printf("PowerStateShm_Open: mmap failed (%s)\n", strerror(errno));
+        shm = NULL;
+        return -1;
+    }
+
+    /* A previous instance may have left a segment behind, restart it from scratch */
+    __atomic_store_n(&shm->magic, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    shm->version = POWER_STATE_SHM_VERSION;
+    shm->sequence = 0;
+    shm->currentState = 0;
+    shm->previousState = 0;
+    shm->transitions = 0;
+    shm->changedMonotonicNs = 0;
+    shm->changedRealtimeNs = 0;
+    shm->publisherPid = (int32_t)getpid();
+    shm->publisherStartTicks = PowerStateShm_ProcessStartTicks(getpid());
+    __atomic_store_n(&shm->magic, POWER_STATE_SHM_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void PowerStateShm_Publish(int currentState, int previousState, int transition,
+                           uint64_t changedMonotonicNs, uint64_t changedRealtimeNs)
+{
+    uint32_t sequence;
+
+    if (shm == NULL) {
+        return;
+    }
+
+    sequence = shm->sequence;
+    __atomic_store_n(&shm->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&shm->currentState, currentState, __ATOMIC_RELAXED);
+    __atomic_store_n(&shm->previousState, previousState, __ATOMIC_RELAXED);
+    if (transition) {
+        __atomic_store_n(&shm->transitions, shm->transitions + 1, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&shm->changedMonotonicNs, changedMonotonicNs, __ATOMIC_RELAXED);
+    __atomic_store_n(&shm->changedRealtimeNs, changedRealtimeNs, __ATOMIC_RELAXED);
+    __atomic_store_n(&shm->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+void PowerStateShm_Close(void)
+{
+    if (shm != NULL) {
+        munmap(shm, sizeof(PowerStateShm_t));
+        shm = NULL;
+        shm_unlink(POWER_STATE_SHM_NAME);
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Power state published by pwr-state-monitor in POSIX shared memory.
+ *
+ * The segment is written by the monitor only and protected by a seqlock:
+ * the sequence is odd while an update is in progress. Readers map it once
+ * with PowerStateShm_Map and then call PowerStateShm_Read as often as they
+ * like, which costs a few loads and no system call.
+ *
+ * A monitor that crashes leaves the segment behind with its last state, so
+ * the segment names its publisher by PID and process start time, and
+ * PowerStateShm_PublisherAlive tells readers whether it is still running.
+ */
+#ifndef _POWER_STATE_SHM_H_
+#define _POWER_STATE_SHM_H_
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POWER_STATE_SHM_NAME "/pwr_state"
+#define POWER_STATE_SHM_MAGIC 0x48535350 /* "PSSH" */
+#define POWER_STATE_SHM_VERSION 2
+
+typedef struct _PowerStateShm_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;              /*!< Seqlock, odd while the monitor is writing */
+    int32_t currentState;           /*!< PowerController_PowerState_t */
+    int32_t previousState;
+    int32_t publisherPid;           /*!< pwr-state-monitor writing the segment */
+    uint64_t transitions;           /*!< State changes seen since the monitor started */
+    uint64_t changedMonotonicNs;    /*!< When the current state was reported, CLOCK_MONOTONIC, 0 until the first one is */
+    uint64_t changedRealtimeNs;     /*!< Same, CLOCK_REALTIME */
+    uint64_t publisherStartTicks;   /*!< Start time of publisherPid, tells it from a reused PID */
+} PowerStateShm_t;
+
+typedef struct _PowerStateShm_Snapshot_t {
+    int32_t currentState;
+    int32_t previousState;
+    uint64_t transitions;
+    uint64_t changedMonotonicNs;
+    uint64_t changedRealtimeNs;
+} PowerStateShm_Snapshot_t;
+
+/* Start time of a process in clock ticks since boot (/proc/<pid>/stat field 22), 0 if unknown */
+static inline uint64_t PowerStateShm_ProcessStartTicks(pid_t pid)
+{
+    char path[64], buf[512];
+    unsigned long long ticks = 0;
+    const char* field;
+    FILE* in;
+    size_t len;
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    in = fopen(path, "r");
+    if (in == NULL) {
+        return 0;
+    }
+    len = fread(buf, 1, sizeof(buf) - 1, in);
+    fclose(in);
+    buf[len] = '\0';
+    /* comm may hold spaces and parentheses, fields are counted from the last ')' */
+    field = strrchr(buf, ')');
+    for (int i = 2; (field != NULL) && (i < 22); i++) {
+        field = strchr(field + 1, ' ');
+    }
+    if ((field == NULL) || (sscanf(field, " %llu", &ticks) != 1)) {
+        return 0;
+    }
+    return (uint64_t)ticks;
+}
+
+/* Writer side, used by pwr-state-monitor */
+
+/* Create the segment, it starts out with POWER_STATE_UNKNOWN. Returns 0 on success */
+int PowerStateShm_Open(void);
+
+/* Publish a new state, transition tells whether to count it as a state change */
+void PowerStateShm_Publish(int currentState, int previousState, int transition,
+                           uint64_t changedMonotonicNs, uint64_t changedRealtimeNs);
+
+/* Unmap and remove the segment so readers stop trusting it */
+void PowerStateShm_Close(void);
+
+/* Reader side */
+
+/* Map the segment read only. Returns NULL when the monitor does not publish it */
+static inline const PowerStateShm_t* PowerStateShm_Map(void)
+{
+    const PowerStateShm_t* shm;
+    int fd = shm_open(POWER_STATE_SHM_NAME, O_RDONLY, 0);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    shm = (const PowerStateShm_t*)mmap(NULL, sizeof(PowerStateShm_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        return NULL;
+    }
+    if ((__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) != POWER_STATE_SHM_MAGIC) ||
+        (shm->version != POWER_STATE_SHM_VERSION)) {
+        munmap((void*)shm, sizeof(PowerStateShm_t));
+        return NULL;
+    }
+    return shm;
+}
+
+/* Non zero while the monitor that published the segment is running */
+static inline int PowerStateShm_PublisherAlive(const PowerStateShm_t* shm)
+{
+    pid_t pid = (pid_t)__atomic_load_n(&shm->publisherPid, __ATOMIC_RELAXED);
+    uint64_t startTicks;
+
+    if ((pid <= 0) || ((kill(pid, 0) != 0) && (errno != EPERM))) {
+        return 0;
+    }
+    /* Without /proc the PID check has to do */
+    startTicks = PowerStateShm_ProcessStartTicks(pid);
+    return (startTicks == 0) || (startTicks == __atomic_load_n(&shm->publisherStartTicks, __ATOMIC_RELAXED));
+}
+
+/* Consistent copy of the published state */
+static inline void PowerStateShm_Read(const PowerStateShm_t* shm, PowerStateShm_Snapshot_t* snapshot)
+{
+    uint32_t begin, end;
+
+    do {
+        begin = __atomic_load_n(&shm->sequence, __ATOMIC_ACQUIRE);
+        snapshot->currentState = __atomic_load_n(&shm->currentState, __ATOMIC_RELAXED);
+        snapshot->previousState = __atomic_load_n(&shm->previousState, __ATOMIC_RELAXED);
+        snapshot->transitions = __atomic_load_n(&shm->transitions, __ATOMIC_RELAXED);
+        snapshot->changedMonotonicNs = __atomic_load_n(&shm->changedMonotonicNs, __ATOMIC_RELAXED);
+        snapshot->changedRealtimeNs = __atomic_load_n(&shm->changedRealtimeNs, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&shm->sequence, __ATOMIC_RELAXED);
+    } while ((begin & 1) || (begin != end));
+}
+
+static inline void PowerStateShm_Unmap(const PowerStateShm_t* shm)
+{
+    munmap((void*)shm, sizeof(PowerStateShm_t));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_STATE_SHM_H_ */
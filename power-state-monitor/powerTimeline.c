@@ -0,0 +1,109 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "powerTimeline.h"
+
+static PowerTimeline_Header_t* header = NULL;
+static PowerTimeline_Record_t* records = NULL;
+static size_t mappedSize = 0;
+
+int PowerTimeline_Open(const char* path, uint32_t capacity)
+{
+    struct stat st;
+    int fd = -1;
+
+    if (capacity == 0) {
+        return -1;
+    }
+    mappedSize = sizeof(PowerTimeline_Header_t) + ((size_t)capacity * sizeof(PowerTimeline_Record_t));
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        printf("PowerTimeline_Open: Not able to open %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size != mappedSize)) {
+        /* New file or another capacity: start over, ftruncate zero fills */
+        if ((ftruncate(fd, 0) != 0) || (ftruncate(fd, (off_t)mappedSize) != 0)) {
+            printf("PowerTimeline_Open: Not able to size %s (%s)\n", path, strerror(errno));
+            close(fd);
+            return -1;
+        }
+    }
+
+    header = (PowerTimeline_Header_t*)mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        printf("PowerTimeline_Open: mmap failed (%s)\n", strerror(errno));
+        header = NULL;
+        return -1;
+    }
+    records = (PowerTimeline_Record_t*)(header + 1);
+
+    /* Keep the history of a previous run if the layout matches */
+    if ((header->magic != POWER_TIMELINE_MAGIC) || (header->version != POWER_TIMELINE_VERSION) ||
+        (header->recordSize != sizeof(PowerTimeline_Record_t)) || (header->capacity != capacity)) {
+        memset(header, 0, mappedSize);
+        header->version = POWER_TIMELINE_VERSION;
+        header->recordSize = sizeof(PowerTimeline_Record_t);
+        header->capacity = capacity;
+        __atomic_store_n(&header->magic, POWER_TIMELINE_MAGIC, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+void PowerTimeline_Record(PowerTimeline_EventType_t type, int fromState, int toState,
+                          int32_t arg1, int32_t arg2, uint64_t monotonicNs, uint64_t realtimeNs)
+{
+    if (header == NULL) {
+        return;
+    }
+
+    uint64_t index = header->head;
+    PowerTimeline_Record_t* record = &records[index % header->capacity];
+
+    __atomic_store_n(&record->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    record->monotonicNs = monotonicNs;
+    record->realtimeNs = realtimeNs;
+    record->type = (uint16_t)type;
+    record->fromState = (uint8_t)fromState;
+    record->toState = (uint8_t)toState;
+    record->arg1 = arg1;
+    record->arg2 = arg2;
+    __atomic_store_n(&record->seq, index + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->head, index + 1, __ATOMIC_RELEASE);
+}
+
+void PowerTimeline_Close(void)
+{
+    if (header != NULL) {
+        munmap(header, mappedSize);
+        header = NULL;
+        records = NULL;
+    }
+}
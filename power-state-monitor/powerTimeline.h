@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Power transition timeline.
+ *
+ * pwr-state-monitor appends every PowerController notification to a fixed
+ * size ring in an mmap'd file; pwr-timeline reads the same file to print
+ * per transition latency histograms. The file layout below is shared by
+ * both and must only be extended in a compatible way.
+ */
+#ifndef _POWER_TIMELINE_H_
+#define _POWER_TIMELINE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POWER_TIMELINE_FILE "/tmp/pwr_timeline.bin"
+#define POWER_TIMELINE_MAGIC 0x4c4e5450 /* "PTNL" */
+#define POWER_TIMELINE_VERSION 1
+#define POWER_TIMELINE_DEFAULT_CAPACITY 2048
+
+typedef enum _PowerTimeline_EventType_t {
+    POWER_TIMELINE_PRE_CHANGE = 1,          /*!< arg1: transactionId, arg2: stateChangeAfter */
+    POWER_TIMELINE_CHANGED = 2,
+    POWER_TIMELINE_DEEP_SLEEP_TIMEOUT = 3,  /*!< arg1: wakeupTimeout */
+    POWER_TIMELINE_REBOOT_BEGIN = 4,
+} PowerTimeline_EventType_t;
+
+typedef struct _PowerTimeline_Header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;      /*!< Records in the ring */
+    uint64_t head;          /*!< Records written since creation, the ring holds the last capacity of them */
+    uint64_t reserved[5];
+} PowerTimeline_Header_t;
+
+typedef struct _PowerTimeline_Record_t {
+    uint64_t seq;           /*!< index + 1, written last; a mismatch means the slot is being rewritten */
+    uint64_t monotonicNs;
+    uint64_t realtimeNs;
+    uint16_t type;          /*!< PowerTimeline_EventType_t */
+    uint8_t fromState;      /*!< PowerController_PowerState_t */
+    uint8_t toState;
+    int32_t arg1;
+    int32_t arg2;
+    uint32_t reserved;
+} PowerTimeline_Record_t;
+
+/* Writer side, used by pwr-state-monitor */
+
+/* Map (creating or resetting if incompatible) the timeline file. Returns 0 on success */
+int PowerTimeline_Open(const char* path, uint32_t capacity);
+
+/* Append one event, timestamps are taken by the caller when the notification arrived */
+void PowerTimeline_Record(PowerTimeline_EventType_t type, int fromState, int toState,
+                          int32_t arg1, int32_t arg2, uint64_t monotonicNs, uint64_t realtimeNs);
+
+void PowerTimeline_Close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _POWER_TIMELINE_H_ */
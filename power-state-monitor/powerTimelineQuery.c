@@ -0,0 +1,324 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * pwr-timeline: print the power transition timeline recorded by
+ * pwr-state-monitor as latency histograms:
+ *   PRE-CHANGE  from the pre-change notification to the state change,
+ *               i.e. the time clients held the transition
+ *   IN <state>  dwell time between entering and leaving a state
+ *   CYCLE       from leaving ON until the box is back ON
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "powerTimeline.h"
+
+#define MAX_STATES 6
+#define STATE_ON 3
+#define HIST_BUCKETS 26 /* < 1 ms, then powers of two up to ~9 h */
+#define HIST_WIDTH 40
+
+typedef struct {
+    uint64_t* values;   /* microseconds */
+    size_t count;
+    size_t size;
+} Series;
+
+static const char* stateNames[MAX_STATES] = { "UNKNOWN", "OFF", "STANDBY", "ON", "LIGHT_SLEEP", "DEEP_SLEEP" };
+
+static Series preChange[MAX_STATES][MAX_STATES];
+static Series dwell[MAX_STATES];
+static Series cycle;
+
+static const char* stateName(int state)
+{
+    return ((state >= 0) && (state < MAX_STATES)) ? stateNames[state] : "?";
+}
+
+static const char* eventName(int type)
+{
+    switch (type) {
+    case POWER_TIMELINE_PRE_CHANGE: return "PRE_CHANGE";
+    case POWER_TIMELINE_CHANGED: return "CHANGED";
+    case POWER_TIMELINE_DEEP_SLEEP_TIMEOUT: return "DEEP_SLEEP_TIMEOUT";
+    case POWER_TIMELINE_REBOOT_BEGIN: return "REBOOT_BEGIN";
+    default: return "?";
+    }
+}
+
+static void addValue(Series* series, uint64_t us)
+{
+    if (series->count == series->size) {
+        size_t size = series->size ? (series->size * 2) : 16;
+        uint64_t* values = (uint64_t*)realloc(series->values, size * sizeof(uint64_t));
+        if (values == NULL) {
+            return;
+        }
+        series->values = values;
+        series->size = size;
+    }
+    series->values[series->count++] = us;
+}
+
+static int compareValues(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void printDuration(char* buf, size_t len, uint64_t us)
+{
+    if (us < 1000) {
+        snprintf(buf, len, "%lluus", (unsigned long long)us);
+    } else if (us < 10000000ULL) {
+        snprintf(buf, len, "%.1fms", us / 1000.0);
+    } else {
+        snprintf(buf, len, "%.1fs", us / 1000000.0);
+    }
+}
+
+static void printSeries(const char* title, Series* series)
+{
+    size_t buckets[HIST_BUCKETS] = { 0 };
+    size_t peak = 0;
+    char p50[16], p90[16], minimum[16], maximum[16];
+
+    if (series->count == 0) {
+        return;
+    }
+    qsort(series->values, series->count, sizeof(uint64_t), compareValues);
+
+    for (size_t i = 0; i < series->count; i++) {
+        uint64_t ms = series->values[i] / 1000;
+        int bucket = 0;
+        while ((ms > 0) && (bucket < HIST_BUCKETS - 1)) {
+            ms >>= 1;
+            bucket++;
+        }
+        buckets[bucket]++;
+        if (buckets[bucket] > peak) {
+            peak = buckets[bucket];
+        }
+    }
+
+    printDuration(minimum, sizeof(minimum), series->values[0]);
+    printDuration(p50, sizeof(p50), series->values[(series->count - 1) / 2]);
+    printDuration(p90, sizeof(p90), series->values[((series->count - 1) * 9) / 10]);
+    printDuration(maximum, sizeof(maximum), series->values[series->count - 1]);
+    printf("%s: count %zu min %s p50 %s p90 %s max %s\n", title, series->count, minimum, p50, p90, maximum);
+
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        char range[32];
+        int bar;
+
+        if (buckets[b] == 0) {
+            continue;
+        }
+        if (b == 0) {
+            snprintf(range, sizeof(range), "< 1 ms");
+        } else if (b == HIST_BUCKETS - 1) {
+            snprintf(range, sizeof(range), ">= %llu ms", 1ULL << (b - 1));
+        } else {
+            snprintf(range, sizeof(range), "%llu - %llu ms", 1ULL << (b - 1), (1ULL << b) - 1);
+        }
+        bar = (int)((buckets[b] * HIST_WIDTH + peak - 1) / peak);
+        printf("  %22s | %-*.*s %zu\n", range, HIST_WIDTH, bar,
+               "########################################", buckets[b]);
+    }
+    printf("\n");
+}
+
+static void printRecord(const PowerTimeline_Record_t* record)
+{
+    time_t sec = (time_t)(record->realtimeNs / 1000000000ULL);
+    struct tm tm_info;
+    char ts[32] = "";
+
+    if (localtime_r(&sec, &tm_info) != NULL) {
+        strftime(ts, sizeof(ts), "%Y-%m-%d %H:%M:%S", &tm_info);
+    }
+    printf("%s.%03llu %-18s %-11s -> %-11s", ts, (unsigned long long)((record->realtimeNs / 1000000ULL) % 1000),
+           eventName(record->type), stateName(record->fromState), stateName(record->toState));
+    if (record->type == POWER_TIMELINE_PRE_CHANGE) {
+        printf(" transaction %d after %d s", record->arg1, record->arg2);
+    } else if (record->type == POWER_TIMELINE_DEEP_SLEEP_TIMEOUT) {
+        printf(" wakeup timeout %d s", record->arg1);
+    }
+    printf("\n");
+}
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [-f FILE] [-l]\n", name);
+    printf("   -f, --file FILE  timeline written by pwr-state-monitor (default %s)\n", POWER_TIMELINE_FILE);
+    printf("   -l, --list       list the recorded events before the histograms\n");
+}
+
+int main(int argc, char* argv[])
+{
+    static struct option options[] = {
+        {"file", required_argument, 0, 'f'},
+        {"list", no_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char* fileName = POWER_TIMELINE_FILE;
+    int list = 0;
+    int opt, fd;
+    struct stat st;
+    const PowerTimeline_Header_t* header;
+    const PowerTimeline_Record_t* records;
+    uint64_t head, first, skipped = 0;
+    /* Pending pre-change per target state, and state entry times */
+    uint64_t preChangeNs[MAX_STATES] = { 0 };
+    int preChangeFrom[MAX_STATES] = { 0 };
+    uint64_t enteredNs = 0, leftOnNs = 0;
+    int currentState = -1;
+
+    while ((opt = getopt_long(argc, argv, "f:lh", options, NULL)) != -1) {
+        switch (opt) {
+        case 'f':
+            fileName = optarg;
+            break;
+        case 'l':
+            list = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        printf("Not able to open %s (%s)\n", fileName, strerror(errno));
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(PowerTimeline_Header_t))) {
+        printf("%s is not a power timeline\n", fileName);
+        close(fd);
+        return 1;
+    }
+    header = (const PowerTimeline_Header_t*)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        printf("mmap failed (%s)\n", strerror(errno));
+        return 1;
+    }
+    if ((header->magic != POWER_TIMELINE_MAGIC) || (header->version != POWER_TIMELINE_VERSION) ||
+        (header->recordSize != sizeof(PowerTimeline_Record_t)) || (header->capacity == 0) ||
+        ((size_t)st.st_size < sizeof(PowerTimeline_Header_t) + ((size_t)header->capacity * sizeof(PowerTimeline_Record_t)))) {
+        printf("%s is not a compatible power timeline\n", fileName);
+        munmap((void*)header, (size_t)st.st_size);
+        return 1;
+    }
+    records = (const PowerTimeline_Record_t*)(header + 1);
+
+    head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    first = (head > header->capacity) ? (head - header->capacity) : 0;
+
+    for (uint64_t index = first; index < head; index++) {
+        const PowerTimeline_Record_t* slot = &records[index % header->capacity];
+        PowerTimeline_Record_t record;
+
+        /* The monitor may be rewriting the oldest slots while we read */
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != index + 1) {
+            skipped++;
+            continue;
+        }
+        record = *slot;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != index + 1) {
+            skipped++;
+            continue;
+        }
+
+        if (list) {
+            printRecord(&record);
+        }
+        if ((record.fromState >= MAX_STATES) || (record.toState >= MAX_STATES)) {
+            continue;
+        }
+
+        if (record.type == POWER_TIMELINE_PRE_CHANGE) {
+            preChangeNs[record.toState] = record.monotonicNs;
+            preChangeFrom[record.toState] = record.fromState;
+        } else if (record.type == POWER_TIMELINE_CHANGED) {
+            if ((preChangeNs[record.toState] != 0) && (preChangeFrom[record.toState] == record.fromState)) {
+                addValue(&preChange[record.fromState][record.toState],
+                         (record.monotonicNs - preChangeNs[record.toState]) / 1000);
+            }
+            preChangeNs[record.toState] = 0;
+
+            /* Monotonic time restarts with the box, only measure within one boot */
+            if ((currentState == record.fromState) && (enteredNs != 0) && (record.monotonicNs >= enteredNs)) {
+                addValue(&dwell[record.fromState], (record.monotonicNs - enteredNs) / 1000);
+            }
+            if ((record.fromState == STATE_ON) && (record.toState != STATE_ON)) {
+                leftOnNs = record.monotonicNs;
+            } else if ((record.toState == STATE_ON) && (leftOnNs != 0) && (record.monotonicNs >= leftOnNs)) {
+                addValue(&cycle, (record.monotonicNs - leftOnNs) / 1000);
+                leftOnNs = 0;
+            }
+            currentState = record.toState;
+            enteredNs = record.monotonicNs;
+        } else if (record.type == POWER_TIMELINE_REBOOT_BEGIN) {
+            currentState = -1;
+            enteredNs = 0;
+            leftOnNs = 0;
+            memset(preChangeNs, 0, sizeof(preChangeNs));
+        }
+    }
+
+    printf("%llu events recorded, %llu in %s",
+           (unsigned long long)head, (unsigned long long)(head - first), fileName);
+    if (skipped > 0) {
+        printf(", %llu being rewritten", (unsigned long long)skipped);
+    }
+    printf("\n\n");
+
+    for (int from = 0; from < MAX_STATES; from++) {
+        for (int to = 0; to < MAX_STATES; to++) {
+            char title[64];
+            snprintf(title, sizeof(title), "PRE-CHANGE %s -> %s", stateName(from), stateName(to));
+            printSeries(title, &preChange[from][to]);
+            free(preChange[from][to].values);
+        }
+    }
+    for (int state = 0; state < MAX_STATES; state++) {
+        char title[64];
+        snprintf(title, sizeof(title), "IN %s", stateName(state));
+        printSeries(title, &dwell[state]);
+        free(dwell[state].values);
+    }
+    printSeries("CYCLE ON -> ON", &cycle);
+    free(cycle.values);
+
+    munmap((void*)header, (size_t)st.st_size);
+    return 0;
+}
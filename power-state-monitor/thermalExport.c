@@ -0,0 +1,225 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * pwr-thermal-export: print the thermal and wakeup time series recorded by
+ * pwr-state-monitor as CSV, oldest record first.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "thermalSeries.h"
+
+static const char* levelName(uint64_t level)
+{
+    switch (level) {
+    case 1: return "NORMAL";
+    case 2: return "HIGH";
+    case 4: return "CRITICAL";
+    default: return "UNKNOWN";
+    }
+}
+
+static const char* wakeupReasonName(uint64_t reason)
+{
+    static const char* names[] = {
+        "UNKNOWN", "IR", "BLUETOOTH", "RF4CE", "GPIO", "LAN", "WIFI", "TIMER", "FRONTPANEL",
+        "WATCHDOG", "SOFTWARERESET", "THERMALRESET", "WARMRESET", "COLDBOOT", "STR_AUTH_FAIL",
+        "CEC", "PRESENCE", "VOICE"
+    };
+    return (reason < sizeof(names) / sizeof(names[0])) ? names[reason] : "UNKNOWN";
+}
+
+static void printTime(uint64_t ms, int epoch)
+{
+    time_t sec = (time_t)(ms / 1000);
+    struct tm tm_info;
+    char ts[32] = "";
+
+    if (epoch) {
+        printf("%llu", (unsigned long long)ms);
+        return;
+    }
+    if (gmtime_r(&sec, &tm_info) != NULL) {
+        strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm_info);
+    }
+    printf("%s.%03lluZ", ts, (unsigned long long)(ms % 1000));
+}
+
+/* Returns the number of records printed, -1 if the block is corrupt */
+static int printBlock(const ThermalSeries_Block_t* block, int epoch)
+{
+    const uint8_t* in = block->data;
+    const uint8_t* end = block->data + block->used;
+    uint64_t ms = block->baseRealtimeMs;
+    int64_t temperature = block->baseTemperature;
+    int count = 0;
+
+    while (in < end) {
+        uint8_t type = *in++;
+        int64_t delta = 0;
+        uint64_t a = 0, b = 0;
+        int64_t keyCode = 0;
+        size_t len;
+
+        if ((len = ThermalSeries_GetSigned(in, end, &delta)) == 0) {
+            return -1;
+        }
+        in += len;
+        ms += (uint64_t)delta;
+
+        if (type == THERMAL_SERIES_WAKEUP) {
+            if ((len = ThermalSeries_GetVarint(in, end, &a)) == 0) {
+                return -1;
+            }
+            in += len;
+            if ((len = ThermalSeries_GetSigned(in, end, &keyCode)) == 0) {
+                return -1;
+            }
+            in += len;
+            printTime(ms, epoch);
+            printf(",wakeup,,,,%s,%lld\n", wakeupReasonName(a), (long long)keyCode);
+        } else if ((type == THERMAL_SERIES_SAMPLE) || (type == THERMAL_SERIES_LEVEL)) {
+            if ((len = ThermalSeries_GetSigned(in, end, &delta)) == 0) {
+                return -1;
+            }
+            in += len;
+            temperature += delta;
+            printTime(ms, epoch);
+            if (type == THERMAL_SERIES_LEVEL) {
+                if ((len = ThermalSeries_GetVarint(in, end, &a)) == 0) {
+                    return -1;
+                }
+                in += len;
+                if ((len = ThermalSeries_GetVarint(in, end, &b)) == 0) {
+                    return -1;
+                }
+                in += len;
+                printf(",level,%.2f,%s,%s,,\n", temperature / 100.0, levelName(a), levelName(b));
+            } else {
+                printf(",sample,%.2f,,,,\n", temperature / 100.0);
+            }
+        } else {
+            return -1;
+        }
+        count++;
+    }
+    return count;
+}
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [-f FILE] [-e]\n", name);
+    printf("   -f, --file FILE  time series written by pwr-state-monitor (default %s)\n", THERMAL_SERIES_FILE);
+    printf("   -e, --epoch      print times as milliseconds since the epoch instead of UTC\n");
+}
+
+int main(int argc, char* argv[])
+{
+    static struct option options[] = {
+        {"file", required_argument, 0, 'f'},
+        {"epoch", no_argument, 0, 'e'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char* fileName = THERMAL_SERIES_FILE;
+    int epoch = 0;
+    int opt, fd;
+    struct stat st;
+    const ThermalSeries_Header_t* header;
+    const ThermalSeries_Block_t* blocks;
+    uint64_t head, first;
+
+    while ((opt = getopt_long(argc, argv, "f:eh", options, NULL)) != -1) {
+        switch (opt) {
+        case 'f':
+            fileName = optarg;
+            break;
+        case 'e':
+            epoch = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Not able to open %s (%s)\n", fileName, strerror(errno));
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(ThermalSeries_Header_t))) {
+        fprintf(stderr, "%s is not a thermal time series\n", fileName);
+        close(fd);
+        return 1;
+    }
+    header = (const ThermalSeries_Header_t*)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        fprintf(stderr, "mmap failed (%s)\n", strerror(errno));
+        return 1;
+    }
+    if ((header->magic != THERMAL_SERIES_MAGIC) || (header->version != THERMAL_SERIES_VERSION) ||
+        (header->blockSize != sizeof(ThermalSeries_Block_t)) || (header->blockCount == 0) ||
+        ((size_t)st.st_size < sizeof(ThermalSeries_Header_t) + ((size_t)header->blockCount * sizeof(ThermalSeries_Block_t)))) {
+        fprintf(stderr, "%s is not a compatible thermal time series\n", fileName);
+        munmap((void*)header, (size_t)st.st_size);
+        return 1;
+    }
+    blocks = (const ThermalSeries_Block_t*)(header + 1);
+
+    head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    first = (head > header->blockCount) ? (head - header->blockCount) : 0;
+
+    printf("time,event,temperature_c,level_from,level_to,wakeup_reason,wakeup_keycode\n");
+    for (uint64_t index = first; index < head; index++) {
+        const ThermalSeries_Block_t* slot = &blocks[index % header->blockCount];
+        ThermalSeries_Block_t copy;
+
+        /* Decode a private copy, the monitor may append or recycle the block meanwhile */
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != index + 1) {
+            continue;
+        }
+        copy.used = __atomic_load_n(&slot->used, __ATOMIC_ACQUIRE);
+        if (copy.used > sizeof(copy.data)) {
+            continue;
+        }
+        copy.baseRealtimeMs = slot->baseRealtimeMs;
+        copy.baseTemperature = slot->baseTemperature;
+        memcpy(copy.data, slot->data, copy.used);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != index + 1) {
+            continue;
+        }
+        if (printBlock(&copy, epoch) < 0) {
+            fprintf(stderr, "Block %llu is corrupt, skipped the rest of it\n", (unsigned long long)index);
+        }
+    }
+
+    munmap((void*)header, (size_t)st.st_size);
+    return 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "power_controller.h"
+#include "monitorLoop.h"
+#include "thermalSampler.h"
+#include "thermalSeries.h"
+
+/* Thermal level change as handed from the PowerController thread to the loop */
+typedef struct {
+    PowerController_ThermalTemperature_t currentLevel;
+    PowerController_ThermalTemperature_t newLevel;
+    float temperature;
+    uint64_t receivedMs;
+} ThermalChange_t;
+
+static ThermalSeries_Header_t* header = NULL;
+static ThermalSeries_Block_t* blocks = NULL;
+static ThermalSeries_Block_t* block = NULL;     /* Block being appended to */
+static size_t mappedSize = 0;
+static int sampleTimer = -1;
+
+/* Last record of the current block, the next one is encoded against it */
+static uint64_t lastMs = 0;
+static int32_t lastTemperature = 0;
+
+static uint64_t now_realtime_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((uint64_t)ts.tv_sec * 1000ULL) + ((uint64_t)ts.tv_nsec / 1000000ULL);
+}
+
+static int32_t centidegrees(float temperature)
+{
+    return (int32_t)lroundf(temperature * 100.0f);
+}
+
+static void startBlock(uint64_t ms, int32_t temperature)
+{
+    uint64_t index = header->head;
+    ThermalSeries_Block_t* next = &blocks[index % header->blockCount];
+
+    /* Readers skip the block while seq is 0 */
+    __atomic_store_n(&next->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    next->baseRealtimeMs = ms;
+    next->baseTemperature = temperature;
+    next->used = 0;
+    next->count = 0;
+    __atomic_store_n(&next->seq, index + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&header->head, index + 1, __ATOMIC_RELEASE);
+
+    block = next;
+    lastMs = ms;
+    lastTemperature = temperature;
+}
+
+static void appendRecord(ThermalSeries_RecordType_t type, uint64_t ms, int32_t temperature,
+                         int64_t arg1, int64_t arg2)
+{
+    uint8_t record[THERMAL_SERIES_MAX_RECORD];
+    size_t len = 0;
+
+    if (header == NULL) {
+        return;
+    }
+    if ((block == NULL) || (block->used + THERMAL_SERIES_MAX_RECORD > sizeof(block->data))) {
+        startBlock(ms, temperature);
+    }
+
+    record[len++] = (uint8_t)type;
+    len += ThermalSeries_PutSigned(record + len, (int64_t)(ms - lastMs));
+    if (type == THERMAL_SERIES_WAKEUP) {
+        len += ThermalSeries_PutVarint(record + len, (uint64_t)arg1);
+        len += ThermalSeries_PutSigned(record + len, arg2);
+    } else {
+        len += ThermalSeries_PutSigned(record + len, (int64_t)temperature - lastTemperature);
+        if (type == THERMAL_SERIES_LEVEL) {
+            len += ThermalSeries_PutVarint(record + len, (uint64_t)arg1);
+            len += ThermalSeries_PutVarint(record + len, (uint64_t)arg2);
+        }
+        lastTemperature = temperature;
+    }
+    lastMs = ms;
+
+    /* Bytes first, then publish them through used */
+    memcpy(block->data + block->used, record, len);
+    block->count++;
+    __atomic_store_n(&block->used, block->used + (uint32_t)len, __ATOMIC_RELEASE);
+}
+
+static void sampleTemperature(void* userdata)
+{
+    float temperature = 0.0f;
+
+    if (PowerController_GetThermalState(&temperature) == POWER_CONTROLLER_ERROR_NONE) {
+        appendRecord(THERMAL_SERIES_SAMPLE, now_realtime_ms(), centidegrees(temperature), 0, 0);
+    }
+}
+
+static void handleThermalChange(const void* data, size_t len)
+{
+    const ThermalChange_t* change = (const ThermalChange_t*)data;
+
+    printf("Thermal level changed %d -> %d (%.1f C)\n", change->currentLevel, change->newLevel, change->temperature);
+    appendRecord(THERMAL_SERIES_LEVEL, change->receivedMs, centidegrees(change->temperature),
+                 change->currentLevel, change->newLevel);
+}
+
+/* Runs on the PowerController thread */
+static void _thermalModeChangedHandler(const PowerController_ThermalTemperature_t currentThermalLevel,
+                                       const PowerController_ThermalTemperature_t newThermalLevel,
+                                       const float currentTemperature, void* userdata)
+{
+    ThermalChange_t change = { currentThermalLevel, newThermalLevel, currentTemperature, now_realtime_ms() };
+
+    if (MonitorLoop_Post(handleThermalChange, &change, sizeof(change)) != 0) {
+        printf("_thermalModeChangedHandler: Failed to queue thermal change\n");
+    }
+}
+
+static int mapSeries(const char* path, uint32_t blockCount)
+{
+    struct stat st;
+    int fd;
+
+    mappedSize = sizeof(ThermalSeries_Header_t) + ((size_t)blockCount * sizeof(ThermalSeries_Block_t));
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        printf("ThermalSampler_Init: Not able to open %s (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size != mappedSize)) {
+        if ((ftruncate(fd, 0) != 0) || (ftruncate(fd, (off_t)mappedSize) != 0)) {
+            printf("ThermalSampler_Init: Not able to size %s (%s)\n", path, strerror(errno));
+            close(fd);
+            return -1;
+        }
+    }
+    header = (ThermalSeries_Header_t*)mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == MAP_FAILED) {
+        printf("ThermalSampler_Init: mmap failed (%s)\n", strerror(errno));
+        header = NULL;
+        return -1;
+    }
+    blocks = (ThermalSeries_Block_t*)(header + 1);
+
+    /* Keep the history of a previous run if the layout matches, new records go to a fresh block */
+    if ((header->magic != THERMAL_SERIES_MAGIC) || (header->version != THERMAL_SERIES_VERSION) ||
+        (header->blockSize != sizeof(ThermalSeries_Block_t)) || (header->blockCount != blockCount)) {
+        memset(header, 0, mappedSize);
+        header->version = THERMAL_SERIES_VERSION;
+        header->blockSize = sizeof(ThermalSeries_Block_t);
+        header->blockCount = blockCount;
+        __atomic_store_n(&header->magic, THERMAL_SERIES_MAGIC, __ATOMIC_RELEASE);
+    }
+    block = NULL;
+    return 0;
+}
+
+int ThermalSampler_Init(const char* path, uint32_t blockCount, uint32_t intervalSec)
+{
+    float temperature = 0.0f;
+
+    if ((blockCount == 0) || (mapSeries(path, blockCount) != 0)) {
+        return -1;
+    }
+
+    sampleTimer = MonitorLoop_AddTimer(intervalSec * 1000, sampleTemperature, NULL);
+    if (sampleTimer < 0) {
+        printf("ThermalSampler_Init: Not able to start the sample timer\n");
+    }
+
+    /* First sample right away, the timer only fires after one interval */
+    if (PowerController_GetThermalState(&temperature) == POWER_CONTROLLER_ERROR_NONE) {
+        appendRecord(THERMAL_SERIES_SAMPLE, now_realtime_ms(), centidegrees(temperature), 0, 0);
+    }
+    PowerController_RegisterThermalModeChangedCallback(_thermalModeChangedHandler, NULL);
+    return 0;
+}
+
+void ThermalSampler_SetInterval(uint32_t intervalSec)
+{
+    MonitorLoop_SetTimer(sampleTimer, intervalSec * 1000);
+}
+
+void ThermalSampler_RecordWakeup(void)
+{
+    PowerController_WakeupReason_t reason = WAKEUP_REASON_UNKNOWN;
+    int keyCode = 0;
+
+    if (header == NULL) {
+        return;
+    }
+    if (PowerController_GetLastWakeupReason(&reason) != POWER_CONTROLLER_ERROR_NONE) {
+        reason = WAKEUP_REASON_UNKNOWN;
+    }
+    if (PowerController_GetLastWakeupKeyCode(&keyCode) != POWER_CONTROLLER_ERROR_NONE) {
+        keyCode = 0;
+    }
+    appendRecord(THERMAL_SERIES_WAKEUP, now_realtime_ms(), lastTemperature, reason, keyCode);
+}
+
+void ThermalSampler_Term(void)
+{
+    if (header == NULL) {
+        return;
+    }
+    PowerController_UnRegisterThermalModeChangedCallback(_thermalModeChangedHandler);
+    if (sampleTimer >= 0) {
+        MonitorLoop_RemoveTimer(sampleTimer);
+        sampleTimer = -1;
+    }
+    munmap(header, mappedSize);
+    header = NULL;
+    blocks = NULL;
+    block = NULL;
+}
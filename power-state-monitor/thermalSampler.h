@@ -0,0 +1,49 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Thermal and wakeup sampler of pwr-state-monitor, writes the time series
+ * described in thermalSeries.h. Everything but the PowerController
+ * callback runs on the monitor loop thread.
+ */
+#ifndef _THERMAL_SAMPLER_H_
+#define _THERMAL_SAMPLER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Map the series file and sample the temperature every intervalSec (0: only
+   level changes and wakeups). Returns 0 on success */
+int ThermalSampler_Init(const char* path, uint32_t blockCount, uint32_t intervalSec);
+
+/* Change the sample period, 0 stops periodic sampling */
+void ThermalSampler_SetInterval(uint32_t intervalSec);
+
+/* Record why the box woke up, call when it comes back ON */
+void ThermalSampler_RecordWakeup(void);
+
+void ThermalSampler_Term(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _THERMAL_SAMPLER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Thermal and wakeup time series.
+ *
+ * The file is a header followed by a fixed number of fixed size blocks used
+ * as a ring, so its size never changes. Each block is decodable on its own:
+ * it starts from a base time and temperature, and every record stores the
+ * difference to the previous record of the block as a zigzag varint:
+ *
+ *   SAMPLE   tag, time delta (ms), temperature delta (1/100 C)
+ *   LEVEL    tag, time delta, temperature delta, from level, to level
+ *   WAKEUP   tag, time delta, reason, zigzag key code
+ *
+ * A periodic sample takes about 5 bytes.
+ */
+#ifndef _THERMAL_SERIES_H_
+#define _THERMAL_SERIES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define THERMAL_SERIES_FILE "/tmp/pwr_thermal.bin"
+#define THERMAL_SERIES_MAGIC 0x4d485450 /* "PTHM" */
+#define THERMAL_SERIES_VERSION 1
+#define THERMAL_SERIES_BLOCK_SIZE 4096
+#define THERMAL_SERIES_DEFAULT_BLOCKS 16
+#define THERMAL_SERIES_MAX_RECORD 32
+
+typedef enum _ThermalSeries_RecordType_t {
+    THERMAL_SERIES_SAMPLE = 1,
+    THERMAL_SERIES_LEVEL = 2,
+    THERMAL_SERIES_WAKEUP = 3,
+} ThermalSeries_RecordType_t;
+
+typedef struct _ThermalSeries_Header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t blockSize;
+    uint32_t blockCount;
+    uint64_t head;              /*!< Blocks started since creation */
+    uint64_t reserved[5];
+} ThermalSeries_Header_t;
+
+typedef struct _ThermalSeries_Block_t {
+    uint64_t seq;               /*!< Block number + 1, 0 while the block is being reset */
+    uint64_t baseRealtimeMs;
+    int32_t baseTemperature;    /*!< 1/100 C */
+    uint32_t used;              /*!< Bytes of data[] holding complete records */
+    uint32_t count;             /*!< Records in the block */
+    uint32_t reserved;
+    uint8_t data[THERMAL_SERIES_BLOCK_SIZE - 32];
+} ThermalSeries_Block_t;
+
+static inline size_t ThermalSeries_PutVarint(uint8_t* out, uint64_t value)
+{
+    size_t len = 0;
+
+    while (value >= 0x80) {
+        out[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[len++] = (uint8_t)value;
+    return len;
+}
+
+static inline size_t ThermalSeries_PutSigned(uint8_t* out, int64_t value)
+{
+    return ThermalSeries_PutVarint(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/* Returns the bytes consumed, 0 if the varint runs past end */
+static inline size_t ThermalSeries_GetVarint(const uint8_t* in, const uint8_t* end, uint64_t* value)
+{
+    size_t len = 0;
+    int shift = 0;
+
+    *value = 0;
+    while ((in + len < end) && (shift < 64)) {
+        uint8_t byte = in[len++];
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return len;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+static inline size_t ThermalSeries_GetSigned(const uint8_t* in, const uint8_t* end, int64_t* value)
+{
+    uint64_t raw;
+    size_t len = ThermalSeries_GetVarint(in, end, &raw);
+
+    *value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+    return len;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _THERMAL_SERIES_H_ */
@@ -0,0 +1,608 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * iarm-broker: local stand-in for the IARM bus daemon
+ *
+ * Members built against the stub libIARMBus.so connect to it over a UNIX
+ * SOCK_SEQPACKET socket. It keeps every member's event subscriptions and
+ * registered calls, fans each broadcast out to the subscribers and routes
+ * IARM_Bus_Call to the member owning the method and the reply back.
+ *
+ * Every delivery from the broker to a member is one hop and is held for
+ * the configured latency (plus random jitter), in order, so a broadcast
+ * costs one hop and a call two.
+ *
+ *   iarm-broker [-s SOCKET] [-l MS] [-j MS] [-v]
+ *
+ * The defaults come from IARM_STUB_SOCKET, IARM_STUB_HOP_LATENCY_MS and
+ * IARM_STUB_HOP_JITTER_MS.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "iarm_stub_protocol.h"
+
+#define MAX_MEMBERS 64
+#define MAX_SUBSCRIPTIONS 256
+#define MAX_METHODS 64
+#define MAX_PENDING_CALLS 256
+#define MAX_HOPS 4096
+
+typedef struct {
+    char owner[IARM_STUB_NAME_SIZE];
+    int32_t eventId;
+} Subscription;
+
+typedef struct {
+    int fd;                     /* -1 when the slot is free */
+    uint32_t generation;        /* Bumped on reuse, so queued hops never reach a newcomer */
+    char name[IARM_STUB_NAME_SIZE];
+    Subscription subscriptions[MAX_SUBSCRIPTIONS];
+    int subscriptionCount;
+    char methods[MAX_METHODS][IARM_STUB_NAME_SIZE];
+    int methodCount;
+} Member;
+
+typedef struct {
+    int used;
+    uint32_t id;
+    int caller, provider;
+    uint32_t callerGeneration, providerGeneration;
+    uint32_t callerCallId;
+} PendingCall;
+
+typedef struct {
+    uint64_t dueNs;
+    int member;
+    uint32_t generation;
+    char* data;                 /* Header followed by its payload */
+} Hop;
+
+static Member members[MAX_MEMBERS];
+static PendingCall pendingCalls[MAX_PENDING_CALLS];
+static uint32_t nextCallId = 1;
+
+/* Deliveries waiting for their due time, due times never decrease */
+static Hop hops[MAX_HOPS];
+static size_t hopHead = 0, hopCount = 0;
+static uint64_t lastDueNs = 0;
+
+static uint64_t hopLatencyNs = 0;
+static uint64_t hopJitterNs = 0;
+static int verbose = 0;
+static int timerFd = -1;
+static volatile sig_atomic_t stopRequested = 0;
+
+static unsigned long long delivered = 0, dropped = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t envMs(const char* name, uint64_t fallback)
+{
+    const char* value = getenv(name);
+    return ((value != NULL) && (*value != '\0')) ? strtoull(value, NULL, 10) : fallback;
+}
+
+static void armTimer(void)
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    if (hopCount > 0) {
+        uint64_t due = hops[hopHead].dueNs;
+        /* 0 would disarm, a due time in the past fires right away */
+        its.it_value.tv_sec = (time_t)(due / 1000000000ULL);
+        its.it_value.tv_nsec = (long)(due % 1000000000ULL);
+        if ((its.it_value.tv_sec == 0) && (its.it_value.tv_nsec == 0)) {
+            its.it_value.tv_nsec = 1;
+        }
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+static void sendNow(int member, const IarmStub_Msg* msg, const void* payload)
+{
+    struct iovec iov[2];
+    struct msghdr mh;
+    size_t len = sizeof(*msg) + msg->length;
+
+    iov[0].iov_base = (void*)msg;
+    iov[0].iov_len = sizeof(*msg);
+    iov[1].iov_base = (void*)payload;
+    iov[1].iov_len = msg->length;
+    memset(&mh, 0, sizeof(mh));
+    mh.msg_iov = iov;
+    mh.msg_iovlen = (msg->length > 0) ? 2 : 1;
+
+    if (sendmsg(members[member].fd, &mh, MSG_NOSIGNAL | MSG_DONTWAIT) != (ssize_t)len) {
+        dropped++;
+        if (verbose) {
+            printf("Dropped %u for %s (%s)\n", msg->type, members[member].name, strerror(errno));
+        }
+        return;
+    }
+    delivered++;
+    if (verbose) {
+        printf("-> %-24s type %u owner %s event %d call %u %u bytes, %.3f ms after sent\n",
+               members[member].name, msg->type, msg->owner, msg->eventId, msg->callId, msg->length,
+               (now_ns() - msg->sentNs) / 1000000.0);
+    }
+}
+
+/* Deliver msg and its data to a member after one hop */
+static void deliver(int member, const IarmStub_Msg* header, const void* payload)
+{
+    size_t len = sizeof(*header) + header->length;
+    uint64_t due;
+    Hop* hop;
+
+    if ((hopLatencyNs == 0) && (hopJitterNs == 0) && (hopCount == 0)) {
+        sendNow(member, header, payload);
+        return;
+    }
+    if (hopCount == MAX_HOPS) {
+        dropped++;
+        printf("Hop queue full, dropped %u for %s\n", header->type, members[member].name);
+        return;
+    }
+
+    due = now_ns() + hopLatencyNs;
+    if (hopJitterNs > 0) {
+        due += (uint64_t)(((double)rand() / RAND_MAX) * (double)hopJitterNs);
+    }
+    if (due < lastDueNs) {
+        due = lastDueNs;
+    }
+    lastDueNs = due;
+
+    hop = &hops[(hopHead + hopCount) % MAX_HOPS];
+    hop->data = (char*)malloc(len);
+    if (hop->data == NULL) {
+        dropped++;
+        return;
+    }
+    memcpy(hop->data, header, sizeof(*header));
+    if (header->length > 0) {
+        memcpy(hop->data + sizeof(*header), payload, header->length);
+    }
+    hop->dueNs = due;
+    hop->member = member;
+    hop->generation = members[member].generation;
+    if (hopCount++ == 0) {
+        armTimer();
+    }
+}
+
+static void flushHops(void)
+{
+    uint64_t expirations;
+    uint64_t now = now_ns();
+
+    if (read(timerFd, &expirations, sizeof(expirations)) < 0) {
+        /* Nothing to read after a re-arm, the queue is checked anyway */
+    }
+    while ((hopCount > 0) && (hops[hopHead].dueNs <= now)) {
+        Hop* hop = &hops[hopHead];
+        if ((members[hop->member].fd >= 0) && (members[hop->member].generation == hop->generation)) {
+            sendNow(hop->member, (const IarmStub_Msg*)hop->data, hop->data + sizeof(IarmStub_Msg));
+        }
+        free(hop->data);
+        hop->data = NULL;
+        hopHead = (hopHead + 1) % MAX_HOPS;
+        hopCount--;
+    }
+    armTimer();
+}
+
+static void reply(int member, uint32_t callId, int32_t result, const void* payload, uint32_t length)
+{
+    IarmStub_Msg msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = IARM_STUB_CALL_REPLY;
+    msg.callId = callId;
+    msg.result = result;
+    msg.length = length;
+    msg.sentNs = now_ns();
+    deliver(member, &msg, payload);
+}
+
+static int findProvider(const char* owner, const char* method)
+{
+    for (int m = 0; m < MAX_MEMBERS; m++) {
+        if ((members[m].fd < 0) || (strcmp(members[m].name, owner) != 0)) {
+            continue;
+        }
+        for (int i = 0; i < members[m].methodCount; i++) {
+            if (strcmp(members[m].methods[i], method) == 0) {
+                return m;
+            }
+        }
+    }
+    return -1;
+}
+
+static void handleEvent(int sender, IarmStub_Msg* msg, const char* payload)
+{
+    int subscribers = 0;
+
+    for (int m = 0; m < MAX_MEMBERS; m++) {
+        if (members[m].fd < 0) {
+            continue;
+        }
+        for (int i = 0; i < members[m].subscriptionCount; i++) {
+            if ((members[m].subscriptions[i].eventId == msg->eventId) &&
+                (strcmp(members[m].subscriptions[i].owner, msg->owner) == 0)) {
+                deliver(m, msg, payload);
+                subscribers++;
+                break;
+            }
+        }
+    }
+    if (verbose) {
+        printf("<- %-24s event %s:%d %u bytes to %d subscribers\n",
+               members[sender].name, msg->owner, msg->eventId, msg->length, subscribers);
+    }
+}
+
+static void handleCall(int caller, IarmStub_Msg* msg, const char* payload)
+{
+    int provider = findProvider(msg->owner, msg->name);
+    PendingCall* call = NULL;
+
+    if (verbose) {
+        printf("<- %-24s call %s.%s %u bytes\n", members[caller].name, msg->owner, msg->name, msg->length);
+    }
+    if (provider < 0) {
+        reply(caller, msg->callId, IARM_STUB_NO_PROVIDER, NULL, 0);
+        return;
+    }
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        if (!pendingCalls[i].used) {
+            call = &pendingCalls[i];
+            break;
+        }
+    }
+    if (call == NULL) {
+        printf("Too many calls in flight, failed %s.%s\n", msg->owner, msg->name);
+        reply(caller, msg->callId, IARM_STUB_PROVIDER_LOST, NULL, 0);
+        return;
+    }
+
+    call->used = 1;
+    call->id = nextCallId++;
+    call->caller = caller;
+    call->callerGeneration = members[caller].generation;
+    call->callerCallId = msg->callId;
+    call->provider = provider;
+    call->providerGeneration = members[provider].generation;
+
+    msg->callId = call->id;
+    deliver(provider, msg, payload);
+}
+
+static void handleCallReply(int provider, IarmStub_Msg* msg, const char* payload)
+{
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        PendingCall* call = &pendingCalls[i];
+        if (!call->used || (call->id != msg->callId) || (call->provider != provider)) {
+            continue;
+        }
+        call->used = 0;
+        if ((members[call->caller].fd >= 0) && (members[call->caller].generation == call->callerGeneration)) {
+            msg->callId = call->callerCallId;
+            deliver(call->caller, msg, payload);
+        }
+        return;
+    }
+}
+
+static void handleIsConnected(int caller, IarmStub_Msg* msg)
+{
+    int connected = 0;
+
+    for (int m = 0; m < MAX_MEMBERS; m++) {
+        if ((members[m].fd >= 0) && (strcmp(members[m].name, msg->owner) == 0)) {
+            connected = 1;
+            break;
+        }
+    }
+    reply(caller, msg->callId, connected, NULL, 0);
+}
+
+static void handleSubscription(Member* member, const IarmStub_Msg* msg)
+{
+    for (int i = 0; i < member->subscriptionCount; i++) {
+        Subscription* sub = &member->subscriptions[i];
+        if ((sub->eventId != msg->eventId) || (strcmp(sub->owner, msg->owner) != 0)) {
+            continue;
+        }
+        if (msg->type == IARM_STUB_UNSUBSCRIBE) {
+            *sub = member->subscriptions[--member->subscriptionCount];
+        }
+        return;
+    }
+    if (msg->type == IARM_STUB_SUBSCRIBE) {
+        if (member->subscriptionCount == MAX_SUBSCRIPTIONS) {
+            printf("%s has too many subscriptions, ignored %s:%d\n", member->name, msg->owner, msg->eventId);
+            return;
+        }
+        memcpy(member->subscriptions[member->subscriptionCount].owner, msg->owner, IARM_STUB_NAME_SIZE);
+        member->subscriptions[member->subscriptionCount].eventId = msg->eventId;
+        member->subscriptionCount++;
+    }
+}
+
+static void handleRegisterCall(Member* member, const IarmStub_Msg* msg)
+{
+    for (int i = 0; i < member->methodCount; i++) {
+        if (strcmp(member->methods[i], msg->name) == 0) {
+            return;
+        }
+    }
+    if (member->methodCount == MAX_METHODS) {
+        printf("%s has too many calls, ignored %s\n", member->name, msg->name);
+        return;
+    }
+    memcpy(member->methods[member->methodCount++], msg->name, IARM_STUB_NAME_SIZE);
+}
+
+static void dropMember(int m)
+{
+    uint32_t generation = members[m].generation;
+
+    if (verbose) {
+        printf("%s disconnected\n", members[m].name);
+    }
+    close(members[m].fd);
+    members[m].fd = -1;
+    members[m].generation++;
+
+    /* Callers waiting on this member get an answer instead of a timeout. Calls
+       it made itself stay pending, their replies are discarded on arrival */
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        PendingCall* call = &pendingCalls[i];
+        if (!call->used || (call->provider != m) || (call->providerGeneration != generation)) {
+            continue;
+        }
+        call->used = 0;
+        if ((members[call->caller].fd >= 0) && (members[call->caller].generation == call->callerGeneration)) {
+            reply(call->caller, call->callerCallId, IARM_STUB_PROVIDER_LOST, NULL, 0);
+        }
+    }
+}
+
+static void handleMember(int m)
+{
+    static char buf[sizeof(IarmStub_Msg) + IARM_STUB_MAX_PAYLOAD];
+    IarmStub_Msg* msg = (IarmStub_Msg*)buf;
+    ssize_t len = recv(members[m].fd, buf, sizeof(buf), 0);
+
+    if (len <= 0) {
+        dropMember(m);
+        return;
+    }
+    if (((size_t)len < sizeof(*msg)) || ((size_t)len != sizeof(*msg) + msg->length)) {
+        printf("Malformed message from %s, %zd bytes\n", members[m].name, len);
+        return;
+    }
+    msg->owner[IARM_STUB_NAME_SIZE - 1] = '\0';
+    msg->name[IARM_STUB_NAME_SIZE - 1] = '\0';
+
+    switch (msg->type) {
+    case IARM_STUB_HELLO:
+        memcpy(members[m].name, msg->owner, IARM_STUB_NAME_SIZE);
+        if (verbose) {
+            printf("%s connected\n", members[m].name);
+        }
+        break;
+    case IARM_STUB_SUBSCRIBE:
+    case IARM_STUB_UNSUBSCRIBE:
+        handleSubscription(&members[m], msg);
+        break;
+    case IARM_STUB_EVENT:
+        handleEvent(m, msg, buf + sizeof(*msg));
+        break;
+    case IARM_STUB_REGISTER_CALL:
+        handleRegisterCall(&members[m], msg);
+        break;
+    case IARM_STUB_CALL:
+        handleCall(m, msg, buf + sizeof(*msg));
+        break;
+    case IARM_STUB_CALL_REPLY:
+        handleCallReply(m, msg, buf + sizeof(*msg));
+        break;
+    case IARM_STUB_IS_CONNECTED:
+        handleIsConnected(m, msg);
+        break;
+    default:
+        printf("Unknown message %u from %s\n", msg->type, members[m].name);
+        break;
+    }
+}
+
+static void acceptMember(int listenFd)
+{
+    int fd = accept4(listenFd, NULL, NULL, SOCK_CLOEXEC);
+
+    if (fd < 0) {
+        return;
+    }
+    for (int m = 0; m < MAX_MEMBERS; m++) {
+        if (members[m].fd < 0) {
+            members[m].fd = fd;
+            snprintf(members[m].name, sizeof(members[m].name), "member%d", m);
+            members[m].subscriptionCount = 0;
+            members[m].methodCount = 0;
+            return;
+        }
+    }
+    printf("Too many members, refused a connection\n");
+    close(fd);
+}
+
+static void onSignal(int sig)
+{
+    (void)sig;
+    stopRequested = 1;
+}
+
+static void usage(const char* name)
+{
+    printf("Usage: %s [-s SOCKET] [-l MS] [-j MS] [-v]\n", name);
+    printf("   -s, --socket SOCKET  socket members connect to (default %s)\n", IARM_STUB_SOCKET);
+    printf("   -l, --latency MS     time every delivery to a member takes (default 0)\n");
+    printf("   -j, --jitter MS      random extra delivery time up to MS (default 0)\n");
+    printf("   -v, --verbose        print every message routed\n");
+}
+
+int main(int argc, char* argv[])
+{
+    static struct option options[] = {
+        {"socket", required_argument, 0, 's'},
+        {"latency", required_argument, 0, 'l'},
+        {"jitter", required_argument, 0, 'j'},
+        {"verbose", no_argument, 0, 'v'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+    const char* socketPath = getenv("IARM_STUB_SOCKET");
+    uint64_t latencyMs = envMs("IARM_STUB_HOP_LATENCY_MS", 0);
+    uint64_t jitterMs = envMs("IARM_STUB_HOP_JITTER_MS", 0);
+    struct sockaddr_un addr;
+    struct pollfd fds[MAX_MEMBERS + 2];
+    int index[MAX_MEMBERS + 2];
+    int listenFd, opt;
+
+    if ((socketPath == NULL) || (*socketPath == '\0')) {
+        socketPath = IARM_STUB_SOCKET;
+    }
+    while ((opt = getopt_long(argc, argv, "s:l:j:vh", options, NULL)) != -1) {
+        switch (opt) {
+        case 's':
+            socketPath = optarg;
+            break;
+        case 'l':
+            latencyMs = strtoull(optarg, NULL, 10);
+            break;
+        case 'j':
+            jitterMs = strtoull(optarg, NULL, 10);
+            break;
+        case 'v':
+            verbose = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+    hopLatencyNs = latencyMs * 1000000ULL;
+    hopJitterNs = jitterMs * 1000000ULL;
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(addr.sun_path)) {
+        printf("Socket path %s is too long\n", socketPath);
+        return 1;
+    }
+    strcpy(addr.sun_path, socketPath);
+
+    listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((listenFd < 0) || (timerFd < 0)) {
+        printf("Not able to create the broker sockets (%s)\n", strerror(errno));
+        return 1;
+    }
+    unlink(socketPath);
+    if ((bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0) || (listen(listenFd, 16) != 0)) {
+        printf("Not able to listen on %s (%s)\n", socketPath, strerror(errno));
+        return 1;
+    }
+    for (int m = 0; m < MAX_MEMBERS; m++) {
+        members[m].fd = -1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+    printf("IARM broker listening on %s, hop latency %llu ms jitter %llu ms\n",
+           socketPath, (unsigned long long)latencyMs, (unsigned long long)jitterMs);
+
+    while (!stopRequested) {
+        int count = 0;
+
+        fds[count].fd = listenFd;
+        fds[count].events = POLLIN;
+        index[count++] = -1;
+        fds[count].fd = timerFd;
+        fds[count].events = POLLIN;
+        index[count++] = -2;
+        for (int m = 0; m < MAX_MEMBERS; m++) {
+            if (members[m].fd >= 0) {
+                fds[count].fd = members[m].fd;
+                fds[count].events = POLLIN;
+                index[count++] = m;
+            }
+        }
+
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("poll failed (%s)\n", strerror(errno));
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            if (index[i] == -1) {
+                acceptMember(listenFd);
+            } else if (index[i] == -2) {
+                flushHops();
+            } else if (members[index[i]].fd == fds[i].fd) {
+                handleMember(index[i]);
+            }
+        }
+    }
+
+    printf("IARM broker stopped, %llu messages delivered, %llu dropped\n", delivered, dropped);
+    close(listenFd);
+    unlink(socketPath);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Wire format between the IARM stub library (iarm_stubs.cpp) and the
+ * local broker (iarm_broker.cpp). One SOCK_SEQPACKET message per request,
+ * a fixed header followed by `length` bytes of event or call data.
+ */
+#ifndef _IARM_STUB_PROTOCOL_H_
+#define _IARM_STUB_PROTOCOL_H_
+
+#include <stdint.h>
+
+#define IARM_STUB_SOCKET "/tmp/iarm_stub.sock"
+#define IARM_STUB_NAME_SIZE 64
+#define IARM_STUB_MAX_PAYLOAD (64 * 1024)
+
+/* Broker results of a CALL_REPLY it generates itself */
+#define IARM_STUB_NO_PROVIDER -1    /* No member of that name has registered the method */
+#define IARM_STUB_PROVIDER_LOST -2  /* The provider disconnected before replying */
+
+typedef enum {
+    IARM_STUB_HELLO = 1,        /* owner: member name */
+    IARM_STUB_SUBSCRIBE,        /* owner, eventId */
+    IARM_STUB_UNSUBSCRIBE,      /* owner, eventId */
+    IARM_STUB_EVENT,            /* owner, eventId, data */
+    IARM_STUB_REGISTER_CALL,    /* name: method */
+    IARM_STUB_CALL,             /* owner: target member, name: method, callId, data */
+    IARM_STUB_CALL_REPLY,       /* callId, result, data */
+    IARM_STUB_IS_CONNECTED,     /* owner: member asked about, callId; replied with CALL_REPLY, result 1 if connected */
+} IarmStub_MsgType;
+
+typedef struct {
+    uint32_t type;
+    uint32_t length;            /* Bytes following the header */
+    int32_t eventId;
+    int32_t result;
+    uint32_t callId;
+    uint32_t reserved;
+    uint64_t sentNs;            /* CLOCK_MONOTONIC when the sender sent it */
+    char owner[IARM_STUB_NAME_SIZE];
+    char name[IARM_STUB_NAME_SIZE];
+} IarmStub_Msg;
+
+#endif /* _IARM_STUB_PROTOCOL_H_ */
@@ -1,73 +1,705 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * IARM bus stub
+ *
+ * IARM_Bus_Connect attaches the process to iarm-broker (iarm_broker.cpp) at
+ * IARM_STUB_SOCKET, so broadcasts reach the members that registered a
+ * handler for them and IARM_Bus_Call runs the method registered by the
+ * owner member, wherever it lives. Event handlers run on a reader thread,
+ * each incoming call on a thread of its own.
+ *
+ * Without a broker the process runs standalone: events and calls only reach
+ * the process itself, and calls to other members succeed without doing
+ * anything, like the original no-op stub.
+ *
+ * Environment:
+ *
+ *   IARM_STUB_SOCKET            broker socket (/tmp/iarm_stub.sock)
+ *   IARM_STUB_CALL_TIMEOUT_MS   IARM_Bus_Call gives up after this (5000)
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
 #include "libIBus.h"
 #include "libIARMCore.h"
-#include <mutex>
-using namespace std;
+#include "iarm_stub_protocol.h"
 
-IARM_Result_t IARM_Malloc(IARM_MemType_t type, size_t size, void **ptr)
+#define MAX_HANDLERS 128
+#define MAX_CALLS 64
+#define MAX_WAITERS 32
+#define DEFAULT_CALL_TIMEOUT_MS 5000
+
+typedef struct {
+    char owner[IARM_STUB_NAME_SIZE];
+    IARM_EventId_t eventId;
+    IARM_EventHandler_t handler;
+} EventHandler;
+
+typedef struct {
+    char name[IARM_STUB_NAME_SIZE];
+    IARM_BusCall_t handler;
+} CallHandler;
+
+/* An IARM_Bus_Call waiting for its reply */
+typedef struct {
+    bool used;
+    bool done;
+    uint32_t callId;
+    int32_t result;
+    void* arg;
+    size_t argLen;
+} Waiter;
+
+/* Incoming call handed to its own thread */
+typedef struct {
+    IARM_BusCall_t handler;
+    uint32_t callId;
+    uint32_t length;
+    char data[];
+} IncomingCall;
+
+/* Everything below is protected by busLock, busCond is broadcast when a reply arrives */
+static pthread_mutex_t busLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t busCond;
+static pthread_once_t busOnce = PTHREAD_ONCE_INIT;
+static char memberName[IARM_STUB_NAME_SIZE] = "";
+static int busFd = -1;
+static bool connected = false;
+static pthread_t readerThread;
+static bool readerRunning = false;
+static EventHandler eventHandlers[MAX_HANDLERS];
+static int eventHandlerCount = 0;
+static CallHandler callHandlers[MAX_CALLS];
+static int callHandlerCount = 0;
+static Waiter waiters[MAX_WAITERS];
+static uint32_t nextCallId = 1;
+
+static void initOnce(void)
 {
-    return IARM_RESULT_SUCCESS;
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&busCond, &attr);
+    pthread_condattr_destroy(&attr);
 }
 
-int main()
+static uint64_t now_ns(void)
 {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
 }
 
-IARM_Result_t IARM_Free(IARM_MemType_t type, void *alloc)
+static void copyName(char* dst, const char* src)
 {
-    return IARM_RESULT_SUCCESS;
+    snprintf(dst, IARM_STUB_NAME_SIZE, "%s", (src != NULL) ? src : "");
 }
 
-IARM_Result_t IARM_Bus_BroadcastEvent(const char *ownerName, IARM_EventId_t eventId, void *arg, size_t argLen)
+/* Send one message to the broker, returns 0 on success */
+static int sendMsg(int fd, IarmStub_Msg* msg, const void* payload, size_t len)
 {
+    struct iovec iov[2];
+    struct msghdr mh;
+
+    if (fd < 0) {
+        return -1;
+    }
+    if (len > IARM_STUB_MAX_PAYLOAD) {
+        printf("IARM stub: %zu bytes is more than the bus carries\n", len);
+        return -1;
+    }
+    msg->length = (uint32_t)len;
+    msg->sentNs = now_ns();
+    iov[0].iov_base = msg;
+    iov[0].iov_len = sizeof(*msg);
+    iov[1].iov_base = (void*)payload;
+    iov[1].iov_len = len;
+    memset(&mh, 0, sizeof(mh));
+    mh.msg_iov = iov;
+    mh.msg_iovlen = (len > 0) ? 2 : 1;
+    return (sendmsg(fd, &mh, MSG_NOSIGNAL) == (ssize_t)(sizeof(*msg) + len)) ? 0 : -1;
+}
+
+static void sendControl(IarmStub_MsgType type, const char* owner, IARM_EventId_t eventId, const char* name)
+{
+    IarmStub_Msg msg;
+    int fd;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = type;
+    msg.eventId = eventId;
+    copyName(msg.owner, owner);
+    copyName(msg.name, name);
+
+    pthread_mutex_lock(&busLock);
+    fd = busFd;
+    pthread_mutex_unlock(&busLock);
+    sendMsg(fd, &msg, NULL, 0);
+}
+
+/* Run the handlers registered for the event, outside busLock */
+static void dispatchEvent(const char* owner, IARM_EventId_t eventId, void* data, size_t len)
+{
+    IARM_EventHandler_t handlers[MAX_HANDLERS];
+    int count = 0;
+
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < eventHandlerCount; i++) {
+        if ((eventHandlers[i].eventId == eventId) && (strcmp(eventHandlers[i].owner, owner) == 0)) {
+            handlers[count++] = eventHandlers[i].handler;
+        }
+    }
+    pthread_mutex_unlock(&busLock);
+
+    for (int i = 0; i < count; i++) {
+        handlers[i](owner, eventId, data, len);
+    }
+}
+
+static IARM_BusCall_t findCall(const char* name)
+{
+    IARM_BusCall_t handler = NULL;
+
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < callHandlerCount; i++) {
+        if (strcmp(callHandlers[i].name, name) == 0) {
+            handler = callHandlers[i].handler;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&busLock);
+    return handler;
+}
+
+static void* callThread(void* arg)
+{
+    IncomingCall* call = (IncomingCall*)arg;
+    IarmStub_Msg msg;
+    int fd;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = IARM_STUB_CALL_REPLY;
+    msg.callId = call->callId;
+    msg.result = call->handler(call->length > 0 ? call->data : NULL);
+
+    pthread_mutex_lock(&busLock);
+    fd = busFd;
+    pthread_mutex_unlock(&busLock);
+    sendMsg(fd, &msg, call->data, call->length);
+    free(call);
+    return NULL;
+}
+
+static void handleCall(int fd, const IarmStub_Msg* msg, const char* payload)
+{
+    IARM_BusCall_t handler = findCall(msg->name);
+    IncomingCall* call;
+    pthread_t thread;
+
+    if (handler == NULL) {
+        IarmStub_Msg reply;
+        memset(&reply, 0, sizeof(reply));
+        reply.type = IARM_STUB_CALL_REPLY;
+        reply.callId = msg->callId;
+        reply.result = IARM_STUB_NO_PROVIDER;
+        sendMsg(fd, &reply, NULL, 0);
+        return;
+    }
+
+    /* A handler may call other members, so it must not block the reader */
+    call = (IncomingCall*)malloc(sizeof(IncomingCall) + msg->length);
+    if (call == NULL) {
+        return;
+    }
+    call->handler = handler;
+    call->callId = msg->callId;
+    call->length = msg->length;
+    memcpy(call->data, payload, msg->length);
+    if (pthread_create(&thread, NULL, callThread, call) != 0) {
+        free(call);
+        return;
+    }
+    pthread_detach(thread);
+}
+
+static void handleReply(const IarmStub_Msg* msg, const char* payload)
+{
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < MAX_WAITERS; i++) {
+        Waiter* waiter = &waiters[i];
+        if (!waiter->used || waiter->done || (waiter->callId != msg->callId)) {
+            continue;
+        }
+        /* The method works on the caller's buffer in place */
+        if ((waiter->arg != NULL) && (msg->length > 0)) {
+            memcpy(waiter->arg, payload, (msg->length < waiter->argLen) ? msg->length : waiter->argLen);
+        }
+        waiter->result = msg->result;
+        waiter->done = true;
+        pthread_cond_broadcast(&busCond);
+        break;
+    }
+    pthread_mutex_unlock(&busLock);
+}
+
+static void* readerLoop(void* arg)
+{
+    int fd = (int)(intptr_t)arg;
+    char* buf = (char*)malloc(sizeof(IarmStub_Msg) + IARM_STUB_MAX_PAYLOAD);
+    IarmStub_Msg* msg = (IarmStub_Msg*)buf;
+
+    while (buf != NULL) {
+        ssize_t len = recv(fd, buf, sizeof(IarmStub_Msg) + IARM_STUB_MAX_PAYLOAD, 0);
+        char* payload = buf + sizeof(IarmStub_Msg);
+
+        if (len <= 0) {
+            if ((len < 0) && (errno == EINTR)) {
+                continue;
+            }
+            break;
+        }
+        if (((size_t)len < sizeof(*msg)) || ((size_t)len != sizeof(*msg) + msg->length)) {
+            continue;
+        }
+        msg->owner[IARM_STUB_NAME_SIZE - 1] = '\0';
+        msg->name[IARM_STUB_NAME_SIZE - 1] = '\0';
+
+        switch (msg->type) {
+        case IARM_STUB_EVENT:
+            dispatchEvent(msg->owner, msg->eventId, (msg->length > 0) ? payload : NULL, msg->length);
+            break;
+        case IARM_STUB_CALL:
+            handleCall(fd, msg, payload);
+            break;
+        case IARM_STUB_CALL_REPLY:
+            handleReply(msg, payload);
+            break;
+        default:
+            break;
+        }
+    }
+    free(buf);
+
+    /* Broker gone or disconnecting, nobody will answer the calls in flight */
+    pthread_mutex_lock(&busLock);
+    if (connected) {
+        printf("IARM stub: lost the broker connection\n");
+    }
+    for (int i = 0; i < MAX_WAITERS; i++) {
+        if (waiters[i].used && !waiters[i].done) {
+            waiters[i].result = IARM_STUB_PROVIDER_LOST;
+            waiters[i].done = true;
+        }
+    }
+    pthread_cond_broadcast(&busCond);
+    pthread_mutex_unlock(&busLock);
+    return NULL;
+}
+
+static IARM_Result_t toResult(int32_t result)
+{
+    switch (result) {
+    case IARM_STUB_NO_PROVIDER:
+        return IARM_RESULT_INVALID_STATE;
+    case IARM_STUB_PROVIDER_LOST:
+        return IARM_RESULT_IPCCORE_FAIL;
+    default:
+        return (IARM_Result_t)result;
+    }
+}
+
+/* Send a request to the broker and wait for the CALL_REPLY, the reply data
+   lands in arg. Returns the raw result or IARM_STUB_PROVIDER_LOST */
+static int32_t brokerRequest(IarmStub_Msg* msg, void* arg, size_t argLen)
+{
+    const char* env = getenv("IARM_STUB_CALL_TIMEOUT_MS");
+    long timeoutMs = ((env != NULL) && (*env != '\0')) ? atol(env) : DEFAULT_CALL_TIMEOUT_MS;
+    uint64_t deadline = now_ns() + ((uint64_t)timeoutMs * 1000000ULL);
+    struct timespec ts;
+    Waiter* waiter = NULL;
+    int32_t result;
+    int fd;
+
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < MAX_WAITERS; i++) {
+        if (!waiters[i].used) {
+            waiter = &waiters[i];
+            break;
+        }
+    }
+    if ((waiter == NULL) || (busFd < 0)) {
+        pthread_mutex_unlock(&busLock);
+        return IARM_STUB_PROVIDER_LOST;
+    }
+    waiter->used = true;
+    waiter->done = false;
+    waiter->callId = msg->callId = nextCallId++;
+    waiter->arg = arg;
+    waiter->argLen = argLen;
+    fd = busFd;
+    pthread_mutex_unlock(&busLock);
+
+    if (sendMsg(fd, msg, arg, (msg->type == IARM_STUB_CALL) ? argLen : 0) != 0) {
+        pthread_mutex_lock(&busLock);
+        waiter->used = false;
+        pthread_mutex_unlock(&busLock);
+        return IARM_STUB_PROVIDER_LOST;
+    }
+
+    ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline % 1000000000ULL);
+    pthread_mutex_lock(&busLock);
+    while (!waiter->done) {
+        if (pthread_cond_timedwait(&busCond, &busLock, &ts) == ETIMEDOUT) {
+            break;
+        }
+    }
+    result = waiter->done ? waiter->result : IARM_STUB_PROVIDER_LOST;
+    waiter->used = false;
+    pthread_mutex_unlock(&busLock);
+    return result;
+}
+
+IARM_Result_t IARM_Malloc(IARM_MemType_t type, size_t size, void **ptr)
+{
+    if (ptr == NULL) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    *ptr = malloc(size);
+    return (*ptr != NULL) ? IARM_RESULT_SUCCESS : IARM_RESULT_OOM;
+}
+
+IARM_Result_t IARM_Free(IARM_MemType_t type, void *alloc)
+{
+    free(alloc);
     return IARM_RESULT_SUCCESS;
 }
 
 IARM_Result_t IARM_Bus_Init(const char* name)
 {
+    if (name == NULL) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_once(&busOnce, initOnce);
+    pthread_mutex_lock(&busLock);
+    copyName(memberName, name);
+    pthread_mutex_unlock(&busLock);
     return IARM_RESULT_SUCCESS;
 }
 
 IARM_Result_t IARM_Bus_Connect()
 {
+    const char* path = getenv("IARM_STUB_SOCKET");
+    struct sockaddr_un addr;
+    IarmStub_Msg hello;
+    int fd;
+
+    pthread_once(&busOnce, initOnce);
+    if ((path == NULL) || (*path == '\0')) {
+        path = IARM_STUB_SOCKET;
+    }
+
+    pthread_mutex_lock(&busLock);
+    if (connected) {
+        pthread_mutex_unlock(&busLock);
+        return IARM_RESULT_SUCCESS;
+    }
+    connected = true;
+    pthread_mutex_unlock(&busLock);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if ((fd < 0) || (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)) {
+        printf("IARM stub: no broker at %s (%s), running standalone\n", path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return IARM_RESULT_SUCCESS;
+    }
+
+    memset(&hello, 0, sizeof(hello));
+    hello.type = IARM_STUB_HELLO;
+    pthread_mutex_lock(&busLock);
+    copyName(hello.owner, memberName);
+    busFd = fd;
+    pthread_mutex_unlock(&busLock);
+    sendMsg(fd, &hello, NULL, 0);
+
+    /* Tell the broker what was registered before Connect */
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < eventHandlerCount; i++) {
+        IarmStub_Msg msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.type = IARM_STUB_SUBSCRIBE;
+        msg.eventId = eventHandlers[i].eventId;
+        copyName(msg.owner, eventHandlers[i].owner);
+        sendMsg(fd, &msg, NULL, 0);
+    }
+    for (int i = 0; i < callHandlerCount; i++) {
+        IarmStub_Msg msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.type = IARM_STUB_REGISTER_CALL;
+        copyName(msg.name, callHandlers[i].name);
+        sendMsg(fd, &msg, NULL, 0);
+    }
+    pthread_mutex_unlock(&busLock);
+
+    if (pthread_create(&readerThread, NULL, readerLoop, (void*)(intptr_t)fd) != 0) {
+        printf("IARM stub: not able to start the reader thread, running standalone\n");
+        pthread_mutex_lock(&busLock);
+        busFd = -1;
+        pthread_mutex_unlock(&busLock);
+        close(fd);
+        return IARM_RESULT_SUCCESS;
+    }
+    readerRunning = true;
     return IARM_RESULT_SUCCESS;
 }
 
-IARM_Result_t IARM_Bus_IsConnected(const char* memberName, int* isRegistered)
+IARM_Result_t IARM_Bus_IsConnected(const char* memberName_, int* isRegistered)
 {
+    IarmStub_Msg msg;
+    int32_t result;
+    bool attached;
+
+    if ((memberName_ == NULL) || (isRegistered == NULL)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_mutex_lock(&busLock);
+    attached = (busFd >= 0);
+    *isRegistered = connected && (strcmp(memberName, memberName_) == 0);
+    pthread_mutex_unlock(&busLock);
+    if (!attached || *isRegistered) {
+        return IARM_RESULT_SUCCESS;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = IARM_STUB_IS_CONNECTED;
+    copyName(msg.owner, memberName_);
+    result = brokerRequest(&msg, NULL, 0);
+    if (result == IARM_STUB_PROVIDER_LOST) {
+        return IARM_RESULT_IPCCORE_FAIL;
+    }
+    *isRegistered = (result == 1);
     return IARM_RESULT_SUCCESS;
 }
 
+IARM_Result_t IARM_Bus_BroadcastEvent(const char *ownerName, IARM_EventId_t eventId, void *arg, size_t argLen)
+{
+    IarmStub_Msg msg;
+    int fd;
+
+    if (ownerName == NULL) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_mutex_lock(&busLock);
+    fd = busFd;
+    pthread_mutex_unlock(&busLock);
+
+    if (fd < 0) {
+        /* Standalone, only this process listens */
+        dispatchEvent(ownerName, eventId, arg, argLen);
+        return IARM_RESULT_SUCCESS;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.type = IARM_STUB_EVENT;
+    msg.eventId = eventId;
+    copyName(msg.owner, ownerName);
+    return (sendMsg(fd, &msg, arg, argLen) == 0) ? IARM_RESULT_SUCCESS : IARM_RESULT_IPCCORE_FAIL;
+}
+
 IARM_Result_t IARM_Bus_RegisterEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler)
 {
+    bool subscribed = false;
+
+    if ((ownerName == NULL) || (handler == NULL)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_mutex_lock(&busLock);
+    if (eventHandlerCount == MAX_HANDLERS) {
+        pthread_mutex_unlock(&busLock);
+        return IARM_RESULT_OOM;
+    }
+    for (int i = 0; i < eventHandlerCount; i++) {
+        if ((eventHandlers[i].eventId == eventId) && (strcmp(eventHandlers[i].owner, ownerName) == 0)) {
+            subscribed = true;
+        }
+    }
+    copyName(eventHandlers[eventHandlerCount].owner, ownerName);
+    eventHandlers[eventHandlerCount].eventId = eventId;
+    eventHandlers[eventHandlerCount].handler = handler;
+    eventHandlerCount++;
+    pthread_mutex_unlock(&busLock);
+
+    if (!subscribed) {
+        sendControl(IARM_STUB_SUBSCRIBE, ownerName, eventId, NULL);
+    }
     return IARM_RESULT_SUCCESS;
 }
 
+/* Remove the handler, or every handler of the event when handler is NULL */
+static IARM_Result_t removeHandlers(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler)
+{
+    bool removed = false, remaining = false;
+
+    if (ownerName == NULL) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < eventHandlerCount; ) {
+        EventHandler* entry = &eventHandlers[i];
+        if ((entry->eventId != eventId) || (strcmp(entry->owner, ownerName) != 0)) {
+            i++;
+        } else if ((handler == NULL) || (entry->handler == handler)) {
+            *entry = eventHandlers[--eventHandlerCount];
+            removed = true;
+        } else {
+            remaining = true;
+            i++;
+        }
+    }
+    pthread_mutex_unlock(&busLock);
+
+    if (removed && !remaining) {
+        sendControl(IARM_STUB_UNSUBSCRIBE, ownerName, eventId, NULL);
+    }
+    return removed ? IARM_RESULT_SUCCESS : IARM_RESULT_INVALID_PARAM;
+}
+
 IARM_Result_t IARM_Bus_UnRegisterEventHandler(const char* ownerName, IARM_EventId_t eventId)
 {
-    return IARM_RESULT_SUCCESS;
+    return removeHandlers(ownerName, eventId, NULL);
 }
 
 IARM_Result_t IARM_Bus_RemoveEventHandler(const char* ownerName, IARM_EventId_t eventId, IARM_EventHandler_t handler)
 {
-    return IARM_RESULT_SUCCESS;
+    if (handler == NULL) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    return removeHandlers(ownerName, eventId, handler);
 }
+
 IARM_Result_t IARM_Bus_RegisterCall(const char *methodName, IARM_BusCall_t handler)
 {
-return IARM_RESULT_SUCCESS;
+    if ((methodName == NULL) || (handler == NULL)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    pthread_mutex_lock(&busLock);
+    for (int i = 0; i < callHandlerCount; i++) {
+        if (strcmp(callHandlers[i].name, methodName) == 0) {
+            callHandlers[i].handler = handler;
+            pthread_mutex_unlock(&busLock);
+            return IARM_RESULT_SUCCESS;
+        }
+    }
+    if (callHandlerCount == MAX_CALLS) {
+        pthread_mutex_unlock(&busLock);
+        return IARM_RESULT_OOM;
+    }
+    copyName(callHandlers[callHandlerCount].name, methodName);
+    callHandlers[callHandlerCount].handler = handler;
+    callHandlerCount++;
+    pthread_mutex_unlock(&busLock);
+
+    sendControl(IARM_STUB_REGISTER_CALL, NULL, 0, methodName);
+    return IARM_RESULT_SUCCESS;
 }
+
 IARM_Result_t IARM_Bus_Term(void)
 {
-return IARM_RESULT_SUCCESS;
+    pthread_mutex_lock(&busLock);
+    eventHandlerCount = 0;
+    callHandlerCount = 0;
+    memberName[0] = '\0';
+    pthread_mutex_unlock(&busLock);
+    return IARM_RESULT_SUCCESS;
 }
+
 IARM_Result_t IARM_Bus_Disconnect(void)
 {
-return IARM_RESULT_SUCCESS;
+    int fd;
+
+    pthread_mutex_lock(&busLock);
+    connected = false;
+    fd = busFd;
+    busFd = -1;
+    pthread_mutex_unlock(&busLock);
+
+    if (fd >= 0) {
+        shutdown(fd, SHUT_RDWR);
+        if (readerRunning) {
+            pthread_join(readerThread, NULL);
+            readerRunning = false;
+        }
+        close(fd);
+    }
+    return IARM_RESULT_SUCCESS;
 }
+
 IARM_Result_t IARM_Bus_RegisterEvent(IARM_EventId_t maxEventId)
 {
-return IARM_RESULT_SUCCESS;
+    return IARM_RESULT_SUCCESS;
 }
+
 IARM_Result_t IARM_Bus_Call(const char* ownerName, const char* methodName, void* arg, size_t argLen)
 {
-    return IARM_RESULT_SUCCESS;
+    IARM_BusCall_t handler;
+    IarmStub_Msg msg;
+    bool local, attached;
+
+    if ((ownerName == NULL) || (methodName == NULL)) {
+        return IARM_RESULT_INVALID_PARAM;
+    }
+    if (arg == NULL) {
+        argLen = 0;
+    }
+    pthread_mutex_lock(&busLock);
+    local = (strcmp(ownerName, memberName) == 0);
+    attached = (busFd >= 0);
+    pthread_mutex_unlock(&busLock);
+
+    if (local || !attached) {
+        handler = findCall(methodName);
+        if (handler != NULL) {
+            return handler(arg);
+        }
+        /* Standalone calls to other members keep the old no-op behaviour */
+        return attached ? IARM_RESULT_INVALID_STATE : IARM_RESULT_SUCCESS;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = IARM_STUB_CALL;
+    copyName(msg.owner, ownerName);
+    copyName(msg.name, methodName);
+    return toResult(brokerRequest(&msg, arg, argLen));
 }
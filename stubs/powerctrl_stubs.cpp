@@ -16,64 +16,1022 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+/*
+ * In-process PowerController simulator
+ *
+ * Behaves like a PowerManager plugin on the other end of the RPC link, so
+ * the power tools can be exercised and benchmarked off-box:
+ *
+ *  - A controller thread runs the power state machine. SetPowerState queues
+ *    a transition; each one sends pre-change, then waits until every client
+ *    added with AddPowerModePreChangeClient has called
+ *    PowerModePreChangeComplete for the transaction, or until
+ *    stateChangeAfter seconds have passed, extended by DelayPowerModeChangeBy.
+ *    Then the state changes. Entering DEEP_SLEEP with a SetDeepSleepTimer
+ *    timeout wakes to LIGHT_SLEEP after it, with a DeepSleepTimeout
+ *    notification and wakeup reason TIMER.
+ *  - A dispatcher thread delivers every notification to the registered
+ *    callbacks, in the order they were raised, never on the caller's thread.
+ *
+ * Environment:
+ *
+ *   POWERCTRL_STUB_STATE_CHANGE_AFTER   pre-change timeout in seconds (1)
+ *   POWERCTRL_STUB_NOTIFY_LATENCY_MS    delivery latency of notifications (0)
+ *   POWERCTRL_STUB_CALL_LATENCY_MS      time each request API call takes (0)
+ *   POWERCTRL_STUB_JITTER_MS            random 0..N ms added to both (0)
+ *   POWERCTRL_STUB_TRANSITION_MS        time the platform takes to switch
+ *                                       state after arbitration (0)
+ *   POWERCTRL_STUB_INITIAL_STATE        power state at Init (ON)
+ *   POWERCTRL_STUB_CONNECT_DELAY_MS     stay non operational this long after
+ *                                       Init: Connect fails with NOT_EXIST
+ *                                       until then, and the operational state
+ *                                       callbacks fire when it passes
+ *   POWERCTRL_STUB_SCRIPT               file played back by a script thread,
+ *                                       started when the tool registers its
+ *                                       first notification callback (any but
+ *                                       OperationalStateChange) so nothing
+ *                                       the script raises goes unheard
+ *
+ * Script commands, one per line ('#' starts a comment, states are OFF/
+ * STANDBY/ON/LIGHT_SLEEP/DEEP_SLEEP or their numbers):
+ *
+ *   sleep <ms>
+ *   set <state>             like PowerController_SetPowerState
+ *   prechange <from> <to> <transactionId> <stateChangeAfter>
+ *   changed <from> <to>     forces the state, no arbitration
+ *   deepsleeptimeout <wakeupTimeout>
+ *   reboot <requestor> <reasonCustom> <reasonOther>
+ *   temperature <celsius>   notifies if the thermal level changes
+ *   thermal <from> <to> <celsius>   levels are NORMAL/HIGH/CRITICAL or numbers
+ *   wakeup <reason> <keyCode>       last wakeup reason (number) and key code
+ *   repeat <count>          replay the lines since the previous repeat
+ *                           <count> more times
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
 #include "power_controller.h"
 
+#define MAX_CALLBACKS 4
+#define MAX_CLIENTS 256
+#define MAX_NOTIFICATIONS 256
+#define MAX_REQUESTS 16
+#define DEFAULT_HIGH_TEMPERATURE 100.0f
+#define DEFAULT_CRITICAL_TEMPERATURE 110.0f
+
+template <typename Cb>
+struct CallbackList {
+    Cb callback[MAX_CALLBACKS];
+    void* userdata[MAX_CALLBACKS];
+};
+
+typedef enum {
+    NOTIFY_OPERATIONAL,
+    NOTIFY_PRE_CHANGE,
+    NOTIFY_CHANGED,
+    NOTIFY_DEEP_SLEEP_TIMEOUT,
+    NOTIFY_THERMAL,
+    NOTIFY_REBOOT,
+} NotificationType;
+
+typedef struct {
+    NotificationType type;
+    uint64_t dueNs;
+    int arg[4];             /* States, transaction, timeouts, levels, by type */
+    float temperature;
+    char requestor[64];
+    char reasonCustom[64];
+    char reasonOther[64];
+} Notification;
+
+/* Everything below is protected by stubLock, stubCond is broadcast on any change */
+static pthread_mutex_t stubLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stubCond;
+static pthread_once_t stubOnce = PTHREAD_ONCE_INIT;
+static bool stubStarted = false;
+static bool stubStop = false;
+static pthread_t dispatcherThread;
+static pthread_t controllerThread;
+static pthread_t scriptThread;
+static const char* scriptPath = NULL;
+static bool scriptRunning = false;
+static pthread_t connectThread;
+static bool connectRunning = false;
+static bool stubOperational = true;
+
+/* Injected latencies */
+static int stateChangeAfter = 1;
+static long notifyLatencyMs = 0;
+static long callLatencyMs = 0;
+static long jitterMs = 0;
+static long transitionMs = 0;
+static unsigned int jitterSeed = 1;
+
+/* Power state machine */
+static PowerController_PowerState_t stubCurrentState = POWER_STATE_ON;
+static PowerController_PowerState_t stubPreviousState = POWER_STATE_UNKNOWN;
+static PowerController_PowerState_t requests[MAX_REQUESTS];
+static int requestHead = 0;
+static int requestCount = 0;
+static int stubTransactionId = 0;
+static bool transitionBusy = false;
+static uint64_t transitionDeadlineNs = 0;
+static int deepSleepTimeout = 0;
+static uint64_t deepSleepWakeNs = 0;
+
+/* Pre-change clients */
+static bool clientUsed[MAX_CLIENTS];
+static int clientAckedTransaction[MAX_CLIENTS];
+
+/* Thermal */
+static float stubTemperature = 45.0f;
+static PowerController_ThermalTemperature_t stubThermalLevel = THERMAL_TEMPERATURE_NORMAL;
+static float highTemperature = DEFAULT_HIGH_TEMPERATURE;
+static float criticalTemperature = DEFAULT_CRITICAL_TEMPERATURE;
+static PowerController_WakeupReason_t stubWakeupReason = WAKEUP_REASON_UNKNOWN;
+static int stubWakeupKeyCode = 0;
+
+/* Notifications in the order raised, due times never go backwards */
+static Notification notifications[MAX_NOTIFICATIONS];
+static int notificationHead = 0;
+static int notificationCount = 0;
+static uint64_t lastDueNs = 0;
+
+static CallbackList<PowerController_PowerModeChangedCb> changedCallbacks;
+static CallbackList<PowerController_PowerModePreChangeCb> preChangeCallbacks;
+static CallbackList<PowerController_DeepSleepTimeoutCb> deepSleepTimeoutCallbacks;
+static CallbackList<PowerController_RebootBeginCb> rebootBeginCallbacks;
+static CallbackList<PowerController_ThermalModeChangedCb> thermalCallbacks;
+static CallbackList<PowerController_OperationalStateChangeCb> operationalCallbacks;
+
+template <typename Cb>
+static uint32_t addCallback(CallbackList<Cb>& list, Cb callback, void* userdata)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_GENERAL;
+
+    pthread_mutex_lock(&stubLock);
+    for (int i = 0; i < MAX_CALLBACKS; i++) {
+        if (list.callback[i] == callback) {
+            break;
+        }
+        if (list.callback[i] == NULL) {
+            list.callback[i] = callback;
+            list.userdata[i] = userdata;
+            status = POWER_CONTROLLER_ERROR_NONE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+template <typename Cb>
+static uint32_t removeCallback(CallbackList<Cb>& list, Cb callback)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_NOT_EXIST;
+
+    pthread_mutex_lock(&stubLock);
+    for (int i = 0; i < MAX_CALLBACKS; i++) {
+        if (list.callback[i] == callback) {
+            list.callback[i] = NULL;
+            list.userdata[i] = NULL;
+            status = POWER_CONTROLLER_ERROR_NONE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+/* Callbacks run without the lock, take a copy first */
+template <typename Cb>
+static CallbackList<Cb> snapshot(const CallbackList<Cb>& list)
+{
+    pthread_mutex_lock(&stubLock);
+    CallbackList<Cb> copy = list;
+    pthread_mutex_unlock(&stubLock);
+    return copy;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void initOnce(void)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&stubCond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* Called with stubLock held. Returns false once stubStop is set or dueNs passed */
+static bool waitUntil(uint64_t dueNs)
+{
+    struct timespec ts = { (time_t)(dueNs / 1000000000ULL), (long)(dueNs % 1000000000ULL) };
+
+    return !stubStop && (pthread_cond_timedwait(&stubCond, &stubLock, &ts) == 0);
+}
+
+/* Called with stubLock held */
+static long jitterLocked(void)
+{
+    return (jitterMs > 0) ? (long)(rand_r(&jitterSeed) % (unsigned int)(jitterMs + 1)) : 0;
+}
+
+/* Round trip of a request API call */
+static void callLatency(void)
+{
+    long ms;
+
+    pthread_mutex_lock(&stubLock);
+    ms = callLatencyMs + jitterLocked();
+    pthread_mutex_unlock(&stubLock);
+    if (ms > 0) {
+        struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+        nanosleep(&ts, NULL);
+    }
+}
+
+/* Called with stubLock held */
+static void postLocked(const Notification* notification)
+{
+    uint64_t dueNs = now_ns() + ((uint64_t)(notifyLatencyMs + jitterLocked()) * 1000000ULL);
+
+    if (notificationCount == MAX_NOTIFICATIONS) {
+        printf("powerctrl stub: notification queue full, dropped type %d\n", notification->type);
+        return;
+    }
+    /* RPC delivers in order, jitter must not reorder */
+    if (dueNs < lastDueNs) {
+        dueNs = lastDueNs;
+    }
+    lastDueNs = dueNs;
+
+    Notification* slot = &notifications[(notificationHead + notificationCount) % MAX_NOTIFICATIONS];
+    *slot = *notification;
+    slot->dueNs = dueNs;
+    notificationCount++;
+    pthread_cond_broadcast(&stubCond);
+}
+
+static void post(const Notification* notification)
+{
+    pthread_mutex_lock(&stubLock);
+    postLocked(notification);
+    pthread_mutex_unlock(&stubLock);
+}
+
+static void postStates(NotificationType type, int a, int b, int c, int d)
+{
+    Notification notification;
+
+    memset(&notification, 0, sizeof(notification));
+    notification.type = type;
+    notification.arg[0] = a;
+    notification.arg[1] = b;
+    notification.arg[2] = c;
+    notification.arg[3] = d;
+    post(&notification);
+}
+
+static void postThermal(int from, int to, float temperature)
+{
+    Notification notification;
+
+    memset(&notification, 0, sizeof(notification));
+    notification.type = NOTIFY_THERMAL;
+    notification.arg[0] = from;
+    notification.arg[1] = to;
+    notification.temperature = temperature;
+    post(&notification);
+}
+
+static void postReboot(const char* requestor, const char* reasonCustom, const char* reasonOther)
+{
+    Notification notification;
+
+    memset(&notification, 0, sizeof(notification));
+    notification.type = NOTIFY_REBOOT;
+    snprintf(notification.requestor, sizeof(notification.requestor), "%s", requestor);
+    snprintf(notification.reasonCustom, sizeof(notification.reasonCustom), "%s", reasonCustom);
+    snprintf(notification.reasonOther, sizeof(notification.reasonOther), "%s", reasonOther);
+    post(&notification);
+}
+
+static void deliver(const Notification* n)
+{
+    switch (n->type) {
+    case NOTIFY_OPERATIONAL: {
+        CallbackList<PowerController_OperationalStateChangeCb> list = snapshot(operationalCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i](n->arg[0] != 0, list.userdata[i]);
+            }
+        }
+        break;
+    }
+    case NOTIFY_PRE_CHANGE: {
+        CallbackList<PowerController_PowerModePreChangeCb> list = snapshot(preChangeCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i]((PowerController_PowerState_t)n->arg[0], (PowerController_PowerState_t)n->arg[1],
+                                 n->arg[2], n->arg[3], list.userdata[i]);
+            }
+        }
+        break;
+    }
+    case NOTIFY_CHANGED: {
+        CallbackList<PowerController_PowerModeChangedCb> list = snapshot(changedCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i]((PowerController_PowerState_t)n->arg[0], (PowerController_PowerState_t)n->arg[1], list.userdata[i]);
+            }
+        }
+        break;
+    }
+    case NOTIFY_DEEP_SLEEP_TIMEOUT: {
+        CallbackList<PowerController_DeepSleepTimeoutCb> list = snapshot(deepSleepTimeoutCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i](n->arg[0], list.userdata[i]);
+            }
+        }
+        break;
+    }
+    case NOTIFY_THERMAL: {
+        CallbackList<PowerController_ThermalModeChangedCb> list = snapshot(thermalCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i]((PowerController_ThermalTemperature_t)n->arg[0], (PowerController_ThermalTemperature_t)n->arg[1],
+                                 n->temperature, list.userdata[i]);
+            }
+        }
+        break;
+    }
+    case NOTIFY_REBOOT: {
+        CallbackList<PowerController_RebootBeginCb> list = snapshot(rebootBeginCallbacks);
+        for (int i = 0; i < MAX_CALLBACKS; i++) {
+            if (list.callback[i] != NULL) {
+                list.callback[i](n->reasonCustom, n->reasonOther, n->requestor, list.userdata[i]);
+            }
+        }
+        break;
+    }
+    }
+}
+
+static void* dispatcherMain(void* arg)
+{
+    pthread_mutex_lock(&stubLock);
+    while (!stubStop) {
+        if (notificationCount == 0) {
+            pthread_cond_wait(&stubCond, &stubLock);
+        } else if (notifications[notificationHead].dueNs > now_ns()) {
+            waitUntil(notifications[notificationHead].dueNs);
+        } else {
+            Notification notification = notifications[notificationHead];
+
+            notificationHead = (notificationHead + 1) % MAX_NOTIFICATIONS;
+            notificationCount--;
+            pthread_mutex_unlock(&stubLock);
+            deliver(&notification);
+            pthread_mutex_lock(&stubLock);
+        }
+    }
+    pthread_mutex_unlock(&stubLock);
+    return NULL;
+}
+
+/* Called with stubLock held */
+static bool queueRequestLocked(PowerController_PowerState_t state)
+{
+    if (requestCount == MAX_REQUESTS) {
+        return false;
+    }
+    requests[(requestHead + requestCount) % MAX_REQUESTS] = state;
+    requestCount++;
+    pthread_cond_broadcast(&stubCond);
+    return true;
+}
+
+/* Called with stubLock held */
+static bool allClientsAcked(int transactionId)
+{
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (clientUsed[i] && (clientAckedTransaction[i] != transactionId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Called with stubLock held; notifications are only queued here, the lock
+ * is released just while waiting for the acks and the transition time */
+static void runTransition(PowerController_PowerState_t to)
+{
+    PowerController_PowerState_t from = stubCurrentState;
+    int transactionId;
+
+    if (to == from) {
+        return;
+    }
+    transactionId = ++stubTransactionId;
+    transitionBusy = true;
+    transitionDeadlineNs = now_ns() + ((uint64_t)stateChangeAfter * 1000000000ULL);
+
+    Notification preChange;
+    memset(&preChange, 0, sizeof(preChange));
+    preChange.type = NOTIFY_PRE_CHANGE;
+    preChange.arg[0] = from;
+    preChange.arg[1] = to;
+    preChange.arg[2] = transactionId;
+    preChange.arg[3] = stateChangeAfter;
+    postLocked(&preChange);
+
+    /* DelayPowerModeChangeBy moves the deadline and wakes us, so re-read it every time */
+    while (!stubStop && !allClientsAcked(transactionId) && (now_ns() < transitionDeadlineNs)) {
+        waitUntil(transitionDeadlineNs);
+    }
+    if (transitionMs > 0) {
+        uint64_t doneNs = now_ns() + ((uint64_t)transitionMs * 1000000ULL);
+        while (!stubStop && (now_ns() < doneNs)) {
+            waitUntil(doneNs);
+        }
+    }
+    transitionBusy = false;
+    if (stubStop) {
+        return;
+    }
+
+    stubPreviousState = from;
+    stubCurrentState = to;
+    deepSleepWakeNs = ((to == POWER_STATE_STANDBY_DEEP_SLEEP) && (deepSleepTimeout > 0)) ?
+                      now_ns() + ((uint64_t)deepSleepTimeout * 1000000000ULL) : 0;
+
+    Notification changed;
+    memset(&changed, 0, sizeof(changed));
+    changed.type = NOTIFY_CHANGED;
+    changed.arg[0] = from;
+    changed.arg[1] = to;
+    postLocked(&changed);
+}
+
+/* The power state machine, one transition at a time */
+static void* controllerMain(void* arg)
+{
+    pthread_mutex_lock(&stubLock);
+    while (!stubStop) {
+        if (requestCount > 0) {
+            PowerController_PowerState_t to = requests[requestHead];
+
+            requestHead = (requestHead + 1) % MAX_REQUESTS;
+            requestCount--;
+            runTransition(to);
+        } else if ((deepSleepWakeNs != 0) && (now_ns() >= deepSleepWakeNs)) {
+            Notification timeout;
+
+            deepSleepWakeNs = 0;
+            stubWakeupReason = WAKEUP_REASON_TIMER;
+            stubWakeupKeyCode = 0;
+            memset(&timeout, 0, sizeof(timeout));
+            timeout.type = NOTIFY_DEEP_SLEEP_TIMEOUT;
+            timeout.arg[0] = deepSleepTimeout;
+            postLocked(&timeout);
+            queueRequestLocked(POWER_STATE_STANDBY_LIGHT_SLEEP);
+        } else if (deepSleepWakeNs != 0) {
+            waitUntil(deepSleepWakeNs);
+        } else {
+            pthread_cond_wait(&stubCond, &stubLock);
+        }
+    }
+    pthread_mutex_unlock(&stubLock);
+    return NULL;
+}
+
+static int parseState(const char* name)
+{
+    static const char* names[] = { "UNKNOWN", "OFF", "STANDBY", "ON", "LIGHT_SLEEP", "DEEP_SLEEP" };
+
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcasecmp(name, names[i]) == 0) {
+            return i;
+        }
+    }
+    return atoi(name);
+}
+
+static int parseThermalLevel(const char* name)
+{
+    if (strcasecmp(name, "NORMAL") == 0) {
+        return THERMAL_TEMPERATURE_NORMAL;
+    } else if (strcasecmp(name, "HIGH") == 0) {
+        return THERMAL_TEMPERATURE_HIGH;
+    } else if (strcasecmp(name, "CRITICAL") == 0) {
+        return THERMAL_TEMPERATURE_CRITICAL;
+    }
+    return atoi(name);
+}
+
+/* Called with stubLock held */
+static PowerController_ThermalTemperature_t thermalLevelLocked(float temperature)
+{
+    if (temperature >= criticalTemperature) {
+        return THERMAL_TEMPERATURE_CRITICAL;
+    }
+    return (temperature >= highTemperature) ? THERMAL_TEMPERATURE_HIGH : THERMAL_TEMPERATURE_NORMAL;
+}
+
+/* Returns false when PowerController_Term asked the script to stop */
+static bool scriptSleep(long ms)
+{
+    uint64_t dueNs = now_ns() + ((uint64_t)ms * 1000000ULL);
+    bool stop;
+
+    pthread_mutex_lock(&stubLock);
+    while (!stubStop && (now_ns() < dueNs)) {
+        waitUntil(dueNs);
+    }
+    stop = stubStop;
+    pthread_mutex_unlock(&stubLock);
+    return !stop;
+}
+
+static bool runScriptLine(char* line)
+{
+    char cmd[32] = { 0 };
+    char a[64] = { 0 }, b[64] = { 0 }, c[64] = { 0 }, d[64] = { 0 };
+    char* comment = strchr(line, '#');
+
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+    if (sscanf(line, "%31s %63s %63s %63s %63s", cmd, a, b, c, d) < 1) {
+        return true;
+    }
+
+    if (strcmp(cmd, "sleep") == 0) {
+        return scriptSleep(atol(a));
+    } else if (strcmp(cmd, "set") == 0) {
+        pthread_mutex_lock(&stubLock);
+        if (!queueRequestLocked((PowerController_PowerState_t)parseState(a))) {
+            printf("powerctrl stub: too many transitions queued, 'set %s' dropped\n", a);
+        }
+        pthread_mutex_unlock(&stubLock);
+    } else if (strcmp(cmd, "prechange") == 0) {
+        postStates(NOTIFY_PRE_CHANGE, parseState(a), parseState(b), atoi(c), atoi(d));
+    } else if (strcmp(cmd, "changed") == 0) {
+        PowerController_PowerState_t from = (PowerController_PowerState_t)parseState(a);
+        PowerController_PowerState_t to = (PowerController_PowerState_t)parseState(b);
+
+        pthread_mutex_lock(&stubLock);
+        stubPreviousState = from;
+        stubCurrentState = to;
+        pthread_mutex_unlock(&stubLock);
+        postStates(NOTIFY_CHANGED, from, to, 0, 0);
+    } else if (strcmp(cmd, "deepsleeptimeout") == 0) {
+        postStates(NOTIFY_DEEP_SLEEP_TIMEOUT, atoi(a), 0, 0, 0);
+    } else if (strcmp(cmd, "reboot") == 0) {
+        postReboot(a, b, c);
+    } else if (strcmp(cmd, "temperature") == 0) {
+        float temperature = strtof(a, NULL);
+        PowerController_ThermalTemperature_t from, to;
+
+        pthread_mutex_lock(&stubLock);
+        stubTemperature = temperature;
+        from = stubThermalLevel;
+        to = stubThermalLevel = thermalLevelLocked(temperature);
+        pthread_mutex_unlock(&stubLock);
+        if (from != to) {
+            postThermal(from, to, temperature);
+        }
+    } else if (strcmp(cmd, "thermal") == 0) {
+        float temperature = strtof(c, NULL);
+
+        pthread_mutex_lock(&stubLock);
+        stubTemperature = temperature;
+        stubThermalLevel = (PowerController_ThermalTemperature_t)parseThermalLevel(b);
+        pthread_mutex_unlock(&stubLock);
+        postThermal(parseThermalLevel(a), parseThermalLevel(b), temperature);
+    } else if (strcmp(cmd, "wakeup") == 0) {
+        pthread_mutex_lock(&stubLock);
+        stubWakeupReason = (PowerController_WakeupReason_t)atoi(a);
+        stubWakeupKeyCode = atoi(b);
+        pthread_mutex_unlock(&stubLock);
+    } else {
+        printf("powerctrl stub: unknown script command '%s'\n", cmd);
+    }
+    return true;
+}
+
+static void* scriptMain(void* arg)
+{
+    FILE* script = fopen((const char*)arg, "r");
+    char line[256];
+    long start = 0;
+    int remaining = -1;
+
+    if (script == NULL) {
+        printf("powerctrl stub: not able to open script %s\n", (const char*)arg);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof(line), script) != NULL) {
+        int count = 0;
+
+        if (sscanf(line, " repeat %d", &count) == 1) {
+            long next = ftell(script);
+
+            if (remaining < 0) {
+                remaining = count;
+            }
+            if (remaining-- > 0) {
+                fseek(script, start, SEEK_SET);
+            } else {
+                remaining = -1;
+                start = next;
+            }
+            continue;
+        }
+        if (!runScriptLine(line)) {
+            break;
+        }
+    }
+    fclose(script);
+    return NULL;
+}
+
+static void* connectMain(void* arg)
+{
+    if (!scriptSleep((long)(intptr_t)arg)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&stubLock);
+    stubOperational = true;
+    pthread_mutex_unlock(&stubLock);
+    postStates(NOTIFY_OPERATIONAL, 1, 0, 0, 0);
+    return NULL;
+}
+
+/* Play the script once a callback can hear it, at most once per Init */
+static void startScript(void)
+{
+    pthread_mutex_lock(&stubLock);
+    if (stubStarted && !stubStop && (scriptPath != NULL) && !scriptRunning) {
+        scriptRunning = (pthread_create(&scriptThread, NULL, scriptMain, (void*)scriptPath) == 0);
+    }
+    pthread_mutex_unlock(&stubLock);
+}
+
+static long envLong(const char* name, long fallback)
+{
+    const char* value = getenv(name);
+    return (value != NULL) ? atol(value) : fallback;
+}
+
 void PowerController_Init()
 {
+    const char* script = getenv("POWERCTRL_STUB_SCRIPT");
+    const char* initialState = getenv("POWERCTRL_STUB_INITIAL_STATE");
+    long connectDelay = envLong("POWERCTRL_STUB_CONNECT_DELAY_MS", 0);
+
+    pthread_once(&stubOnce, initOnce);
 
+    pthread_mutex_lock(&stubLock);
+    if (stubStarted) {
+        pthread_mutex_unlock(&stubLock);
+        return;
+    }
+    stubStarted = true;
+    stubStop = false;
+    stateChangeAfter = (int)envLong("POWERCTRL_STUB_STATE_CHANGE_AFTER", 1);
+    notifyLatencyMs = envLong("POWERCTRL_STUB_NOTIFY_LATENCY_MS", 0);
+    callLatencyMs = envLong("POWERCTRL_STUB_CALL_LATENCY_MS", 0);
+    jitterMs = envLong("POWERCTRL_STUB_JITTER_MS", 0);
+    transitionMs = envLong("POWERCTRL_STUB_TRANSITION_MS", 0);
+    jitterSeed = (unsigned int)now_ns();
+    if (initialState != NULL) {
+        stubCurrentState = (PowerController_PowerState_t)parseState(initialState);
+    }
+    stubOperational = (connectDelay <= 0);
+    scriptPath = script;
+    pthread_mutex_unlock(&stubLock);
+
+    pthread_create(&dispatcherThread, NULL, dispatcherMain, NULL);
+    pthread_create(&controllerThread, NULL, controllerMain, NULL);
+
+    if (connectDelay > 0) {
+        connectRunning = (pthread_create(&connectThread, NULL, connectMain, (void*)(intptr_t)connectDelay) == 0);
+    }
 }
 
 void PowerController_Term()
 {
+    bool joinScript;
+
+    pthread_once(&stubOnce, initOnce);
+
+    pthread_mutex_lock(&stubLock);
+    if (!stubStarted) {
+        pthread_mutex_unlock(&stubLock);
+        return;
+    }
+    stubStop = true;
+    joinScript = scriptRunning;
+    pthread_cond_broadcast(&stubCond);
+    pthread_mutex_unlock(&stubLock);
 
+    if (joinScript) {
+        pthread_join(scriptThread, NULL);
+    }
+    if (connectRunning) {
+        pthread_join(connectThread, NULL);
+        connectRunning = false;
+    }
+    pthread_join(controllerThread, NULL);
+    pthread_join(dispatcherThread, NULL);
+
+    /* Undelivered notifications and queued transitions die with the connection */
+    pthread_mutex_lock(&stubLock);
+    notificationHead = notificationCount = 0;
+    requestHead = requestCount = 0;
+    lastDueNs = 0;
+    transitionBusy = false;
+    deepSleepWakeNs = 0;
+    scriptRunning = false;
+    scriptPath = NULL;
+    stubStarted = false;
+    pthread_mutex_unlock(&stubLock);
 }
 
 bool PowerController_IsOperational()
 {
-    return true;
+    pthread_mutex_lock(&stubLock);
+    bool operational = stubOperational;
+    pthread_mutex_unlock(&stubLock);
+    return operational;
 }
 
 uint32_t PowerController_Connect()
 {
-    return POWER_CONTROLLER_ERROR_NONE;
+    return PowerController_IsOperational() ? POWER_CONTROLLER_ERROR_NONE : POWER_CONTROLLER_ERROR_NOT_EXIST;
 }
 
 uint32_t PowerController_GetPowerState(PowerController_PowerState_t* currentState, PowerController_PowerState_t* previousState)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    *currentState = stubCurrentState;
+    *previousState = stubPreviousState;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_SetPowerState(const int keyCode, const PowerController_PowerState_t powerstate, const char* reason)
+uint32_t PowerController_GetThermalState(float* currentTemperature)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    *currentTemperature = stubTemperature;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_PowerModePreChangeComplete(const uint32_t clientId, const int transactionId)
+uint32_t PowerController_SetTemperatureThresholds(float high, float critical)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    highTemperature = high;
+    criticalTemperature = critical;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_RegisterPowerModePreChangeCallback(PowerController_PowerModePreChangeCb callback, void* userdata)
+uint32_t PowerController_GetTemperatureThresholds(float* high, float* critical)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    *high = highTemperature;
+    *critical = criticalTemperature;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_UnRegisterPowerModePreChangeCallback(PowerController_PowerModePreChangeCb callback)
+uint32_t PowerController_SetDeepSleepTimer(const int timeOut)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    deepSleepTimeout = timeOut;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_AddPowerModePreChangeClient(const char* clientName, uint32_t* clientId)
+uint32_t PowerController_GetLastWakeupReason(PowerController_WakeupReason_t* wakeupReason)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    *wakeupReason = stubWakeupReason;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_RemovePowerModePreChangeClient(const uint32_t clientId)
+uint32_t PowerController_GetLastWakeupKeyCode(int* keycode)
 {
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    *keycode = stubWakeupKeyCode;
+    pthread_mutex_unlock(&stubLock);
     return POWER_CONTROLLER_ERROR_NONE;
 }
 
-uint32_t PowerController_DelayPowerModeChangeBy(const uint32_t clientId, const int transactionId, const int delayPeriod)
+uint32_t PowerController_Reboot(const char* rebootRequestor, const char* rebootReasonCustom, const char* rebootReasonOther)
 {
+    callLatency();
+    postReboot(rebootRequestor, rebootReasonCustom, rebootReasonOther);
     return POWER_CONTROLLER_ERROR_NONE;
 }
+
+uint32_t PowerController_SetPowerState(const int keyCode, const PowerController_PowerState_t powerstate, const char* reason)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_NONE;
+
+    if ((powerstate <= POWER_STATE_UNKNOWN) || (powerstate > POWER_STATE_STANDBY_DEEP_SLEEP)) {
+        return POWER_CONTROLLER_ERROR_GENERAL;
+    }
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    if (!stubStarted || !stubOperational) {
+        status = POWER_CONTROLLER_ERROR_UNAVAILABLE;
+    } else if (!queueRequestLocked(powerstate)) {
+        status = POWER_CONTROLLER_ERROR_GENERAL;
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+uint32_t PowerController_PowerModePreChangeComplete(const uint32_t clientId, const int transactionId)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_NOT_EXIST;
+
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    if ((clientId >= 1) && (clientId <= MAX_CLIENTS) && clientUsed[clientId - 1]) {
+        clientAckedTransaction[clientId - 1] = transactionId;
+        pthread_cond_broadcast(&stubCond);
+        status = POWER_CONTROLLER_ERROR_NONE;
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+uint32_t PowerController_RegisterPowerModeChangedCallback(PowerController_PowerModeChangedCb callback, void* userdata)
+{
+    uint32_t status = addCallback(changedCallbacks, callback, userdata);
+
+    if (status == POWER_CONTROLLER_ERROR_NONE) {
+        startScript();
+    }
+    return status;
+}
+
+uint32_t PowerController_UnRegisterPowerModeChangedCallback(PowerController_PowerModeChangedCb callback)
+{
+    return removeCallback(changedCallbacks, callback);
+}
+
+uint32_t PowerController_RegisterPowerModePreChangeCallback(PowerController_PowerModePreChangeCb callback, void* userdata)
+{
+    uint32_t status = addCallback(preChangeCallbacks, callback, userdata);
+
+    if (status == POWER_CONTROLLER_ERROR_NONE) {
+        startScript();
+    }
+    return status;
+}
+
+uint32_t PowerController_UnRegisterPowerModePreChangeCallback(PowerController_PowerModePreChangeCb callback)
+{
+    return removeCallback(preChangeCallbacks, callback);
+}
+
+uint32_t PowerController_RegisterDeepSleepTimeoutCallback(PowerController_DeepSleepTimeoutCb callback, void* userdata)
+{
+    uint32_t status = addCallback(deepSleepTimeoutCallbacks, callback, userdata);
+
+    if (status == POWER_CONTROLLER_ERROR_NONE) {
+        startScript();
+    }
+    return status;
+}
+
+uint32_t PowerController_UnRegisterDeepSleepTimeoutCallback(PowerController_DeepSleepTimeoutCb callback)
+{
+    return removeCallback(deepSleepTimeoutCallbacks, callback);
+}
+
+uint32_t PowerController_RegisterRebootBeginCallback(PowerController_RebootBeginCb callback, void* userdata)
+{
+    uint32_t status = addCallback(rebootBeginCallbacks, callback, userdata);
+
+    if (status == POWER_CONTROLLER_ERROR_NONE) {
+        startScript();
+    }
+    return status;
+}
+
+uint32_t PowerController_UnRegisterRebootBeginCallback(PowerController_RebootBeginCb callback)
+{
+    return removeCallback(rebootBeginCallbacks, callback);
+}
+
+uint32_t PowerController_RegisterThermalModeChangedCallback(PowerController_ThermalModeChangedCb callback, void* userdata)
+{
+    uint32_t status = addCallback(thermalCallbacks, callback, userdata);
+
+    if (status == POWER_CONTROLLER_ERROR_NONE) {
+        startScript();
+    }
+    return status;
+}
+
+uint32_t PowerController_UnRegisterThermalModeChangedCallback(PowerController_ThermalModeChangedCb callback)
+{
+    return removeCallback(thermalCallbacks, callback);
+}
+
+uint32_t PowerController_RegisterOperationalStateChangeCallback(PowerController_OperationalStateChangeCb callback, void* userdata)
+{
+    return addCallback(operationalCallbacks, callback, userdata);
+}
+
+uint32_t PowerController_UnRegisterOperationalStateChangeCallback(PowerController_OperationalStateChangeCb callback)
+{
+    return removeCallback(operationalCallbacks, callback);
+}
+
+uint32_t PowerController_AddPowerModePreChangeClient(const char* clientName, uint32_t* clientId)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_GENERAL;
+
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (!clientUsed[i]) {
+            clientUsed[i] = true;
+            /* A client added mid transition has nothing to acknowledge */
+            clientAckedTransaction[i] = stubTransactionId;
+            *clientId = (uint32_t)(i + 1);
+            status = POWER_CONTROLLER_ERROR_NONE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+uint32_t PowerController_RemovePowerModePreChangeClient(const uint32_t clientId)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_NOT_EXIST;
+
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    if ((clientId >= 1) && (clientId <= MAX_CLIENTS) && clientUsed[clientId - 1]) {
+        clientUsed[clientId - 1] = false;
+        pthread_cond_broadcast(&stubCond);
+        status = POWER_CONTROLLER_ERROR_NONE;
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
+
+uint32_t PowerController_DelayPowerModeChangeBy(const uint32_t clientId, const int transactionId, const int delayPeriod)
+{
+    uint32_t status = POWER_CONTROLLER_ERROR_NOT_EXIST;
+
+    callLatency();
+    pthread_mutex_lock(&stubLock);
+    if ((clientId >= 1) && (clientId <= MAX_CLIENTS) && clientUsed[clientId - 1] &&
+        transitionBusy && (transactionId == stubTransactionId)) {
+        uint64_t deadlineNs = now_ns() + ((uint64_t)delayPeriod * 1000000000ULL);
+
+        if (deadlineNs > transitionDeadlineNs) {
+            transitionDeadlineNs = deadlineNs;
+            /* The transition is waiting on the old deadline */
+            pthread_cond_broadcast(&stubCond);
+        }
+        status = POWER_CONTROLLER_ERROR_NONE;
+    }
+    pthread_mutex_unlock(&stubLock);
+    return status;
+}
@@ -0,0 +1,185 @@
+#!/bin/bash
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2026 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+
+#######################################
+#
+# Runs the power tools against the PowerController simulator in stubs/,
+# no PowerManager or IARM needed:
+#
+#   tests/run_stub_tests.sh [BUILD_DIR]
+#
+# Each test plays a script from tests/powerctrl/ and checks what the tool
+# printed. Exits non zero when a test fails. pwr-state-monitor keeps its
+# flags and lightsleep.log in /tmp, so do not run this on a box.
+
+set -e
+
+TOPDIR=$(cd "$(dirname "$0")/.." && pwd)
+SCRIPTS=$TOPDIR/tests/powerctrl
+BUILD=${1:-$(mktemp -d)}
+CFLAGS="-std=gnu11 -Wall -Wextra -Wno-unused-parameter -I$TOPDIR/stubs -I$TOPDIR/power-common -I$TOPDIR/power-state-monitor"
+LIBS="-L$BUILD -lWPEFrameworkPowerController -lpthread -lrt"
+FAILED=0
+
+mkdir -p $BUILD
+g++ -fPIC -shared -fpermissive -I$TOPDIR/stubs -o $BUILD/libWPEFrameworkPowerController.so \
+    $TOPDIR/stubs/powerctrl_stubs.cpp -lpthread
+gcc $CFLAGS -o $BUILD/QueryPowerState $TOPDIR/iarm_query_powerstate/*.c $TOPDIR/power-common/powerConnect.c $LIBS
+gcc $CFLAGS -o $BUILD/SetPowerState $TOPDIR/iarm_set_powerstate/*.c $TOPDIR/power-common/powerConnect.c $LIBS
+gcc $CFLAGS -o $BUILD/pwr-state-monitor $(ls $TOPDIR/power-state-monitor/*.c | \
+    grep -v -e powerTimelineQuery.c -e thermalExport.c) $TOPDIR/power-common/powerConnect.c $LIBS -lm -ldl
+export LD_LIBRARY_PATH=$BUILD${LD_LIBRARY_PATH:+:$LD_LIBRARY_PATH}
+
+set +e
+
+pass()
+{
+    echo "PASS: $1"
+}
+
+fail()
+{
+    echo "FAIL: $1: $2"
+    FAILED=1
+}
+
+# Every state change of sample.txt reaches the watcher, including the
+# first one, raised while PowerManager only just came up
+test_watch_sample()
+{
+    local out=$BUILD/watch_sample.out
+    local expected="STANDBY ON STANDBY ON LIGHTSLEEP ON DEEPSLEEP ON"
+    local changes
+
+    POWERCTRL_STUB_SCRIPT=$SCRIPTS/sample.txt POWERCTRL_STUB_CONNECT_DELAY_MS=200 \
+        timeout -s TERM 2 $BUILD/QueryPowerState -w > $out 2> /dev/null
+    changes=$(awk '$2 == "changed" { printf "%s%s", sep, $3; sep = " " }' $out)
+    if [ "$changes" != "$expected" ]; then
+        fail watch_sample "changes '$changes', expected '$expected'"
+        return
+    fi
+    pass watch_sample
+}
+
+# prechange-burst.txt: every spaced transaction is answered, the ones the
+# ack scheduler or the pending queue had no room for are counted
+test_prechange_burst()
+{
+    local out=$BUILD/prechange_burst.out
+    local received answered dropped
+
+    POWERCTRL_STUB_SCRIPT=$SCRIPTS/prechange-burst.txt \
+        timeout 20 $BUILD/SetPowerState --client C1 --ack 1 --delay 1 --await 1 NOP > $out 2>&1
+    received=$(grep -c '^onPowerModePreChangeEvent.* transactionId: 1,' $out)
+    answered=$(grep -c '^PreChangeComplete transactionId: 1 ' $out)
+    dropped=$(sed -n 's/^\([0-9]*\) of \([0-9]*\) pre-change events not fully answered.*/\1/p' $out)
+    if [ "$received" != 100 ] || [ "$answered" != 100 ]; then
+        fail prechange_burst "transaction 1 received $received times, answered $answered times, expected 100"
+        return
+    fi
+    if ! grep -q '^AckScheduler_Add: Not able to schedule' $out; then
+        fail prechange_burst "the ack scheduler never ran full"
+        return
+    fi
+    if [ -z "$dropped" ] || [ "$dropped" -lt 200 ]; then
+        fail prechange_burst "'$dropped' events counted as not answered, expected at least the 200 of the burst"
+        return
+    fi
+    pass prechange_burst
+}
+
+# Stress mode: 8 clients acking on the scheduler never run into the
+# PowerManager timeout, and every ack goes out
+test_prechange_stress()
+{
+    local out=$BUILD/prechange_stress.out
+    local calls
+
+    if ! timeout 30 $BUILD/SetPowerState --clients 8 --profile fixed:5,random:1-20 --iterations 3 --timeout 900 \
+            STANDBY > $out 2>&1; then
+        fail prechange_stress "transitions timed out"
+        return
+    fi
+    calls=$(sed -n 's/^AckScheduler: \([0-9]*\) calls.*/\1/p' $out)
+    if [ "$calls" != 48 ]; then
+        fail prechange_stress "'$calls' acks sent, expected 48"
+        return
+    fi
+    pass prechange_stress
+}
+
+# pwr-state-monitor plays script NAME.txt and must react to power ON
+# without having woken up in standby, even with a marker left by a
+# killed monitor
+test_lightsleep()
+{
+    local name=$1
+    local log=/tmp/lightsleep.log
+    local offset line pid
+
+    offset=$(stat -c %s $log 2> /dev/null || echo 0)
+    touch /tmp/.lightsleep_on
+    POWERCTRL_STUB_SCRIPT=$SCRIPTS/$name.txt $BUILD/pwr-state-monitor --no-timeline --no-thermal \
+        --no-summary --log-max-size 0 --hook-dir "" > $BUILD/$name.out 2>&1 &
+    pid=$!
+    sleep 1.5
+    kill -TERM $pid
+    wait $pid
+    line=$(tail -c +$((offset + 1)) $log | grep 'Power ON mode from STANDBY')
+    if ! echo "$line" | grep -q 'reaction [0-9]* us, 0 idle wakeups in standby'; then
+        fail $name "got '$line'"
+        return
+    fi
+    if [ -e /tmp/.lightsleep_on ]; then
+        fail $name "/tmp/.lightsleep_on left behind"
+        return
+    fi
+    pass $name
+}
+
+# QueryPowerState -s while pwr-state-monitor still waits for
+# PowerController: the segment exists but holds no state yet, so the
+# query has to ask PowerController itself
+test_shm_unpublished()
+{
+    local out pid
+
+    POWERCTRL_STUB_CONNECT_DELAY_MS=5000 $BUILD/pwr-state-monitor --no-timeline --no-thermal --no-summary \
+        --log-max-size 0 --hook-dir "" > $BUILD/shm_unpublished.out 2>&1 &
+    pid=$!
+    sleep 0.5
+    out=$(POWERCTRL_STUB_INITIAL_STATE=STANDBY $BUILD/QueryPowerState -s 2>&1)
+    kill -TERM $pid
+    wait $pid
+    if ! echo "$out" | grep -q 'not publishing the power state' || [ "$(echo "$out" | tail -1)" != STANDBY ]; then
+        fail shm_unpublished "got '$out'"
+        return
+    fi
+    pass shm_unpublished
+}
+
+test_watch_sample
+test_prechange_burst
+test_prechange_stress
+test_lightsleep lightsleep
+test_lightsleep lightsleep-flap
+test_shm_unpublished
+
+exit $FAILED